@@ -0,0 +1,395 @@
+/*
+	Headless microbenchmarks for the Engine's drawing primitives.
+
+	Every primitive is timed on an Engine drawing into a MemoryTarget, so no
+	window or GPU is needed. Each case is run in batches big enough to swamp
+	the clock's resolution and the fastest batch is kept. Pixel counts are
+	measured, not estimated: the case is drawn once in isolation and the lit
+	pixels counted. GB/s counts color buffer writes only, 4 bytes per pixel.
+	The vertex transforms count vertices in the pixels column instead, so
+	their GB/s means nothing.
+
+	usage: benchmark [--json results.json] [--quick]
+*/
+#include "../view/engine.h"
+#include "../control/logging.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+	struct benchmarkResult {
+		std::string primitive;
+		//what was swept, and the value for this case
+		std::string sweep;
+		std::string size;
+		double pixels;
+		double nsPerCall;
+	};
+
+	//batches shorter than this are made longer, --quick shortens it for smoke runs
+	double minBatchSeconds = 0.1;
+	const int batchCount = 5;
+
+	/**
+		\returns the fastest time for a single call of work, in nanoseconds
+	*/
+	template<typename Work>
+	double time_calls(Work work) {
+
+		using clock = std::chrono::steady_clock;
+
+		//first touch of the buffers, and a guess at how many calls fill a batch
+		work();
+		int calls = 1;
+		for (;;) {
+			clock::time_point start = clock::now();
+			for (int i = 0; i < calls; ++i) {
+				work();
+			}
+			double seconds = std::chrono::duration<double>(clock::now() - start).count();
+			if (seconds >= minBatchSeconds || calls >= (1 << 30)) {
+				break;
+			}
+			calls *= 2;
+		}
+
+		double best = 1e300;
+		for (int batch = 0; batch < batchCount; ++batch) {
+			clock::time_point start = clock::now();
+			for (int i = 0; i < calls; ++i) {
+				work();
+			}
+			best = std::min(best, std::chrono::duration<double, std::nano>(clock::now() - start).count() / calls);
+		}
+		return best;
+	}
+
+	/**
+		\returns how many pixels one call of draw lights up on a black screen
+	*/
+	template<typename Draw>
+	double count_pixels(Engine& engine, renderTarget::MemoryTarget& target, int width, int height, Draw draw) {
+
+		engine.clear_screen(0.0f, 0.0f, 0.0f);
+		draw();
+		engine.render();
+
+		const uint32_t* pixels = reinterpret_cast<const uint32_t*>(target.get_last_frame());
+		double count = 0;
+		for (int i = 0; i < width * height; ++i) {
+			//alpha is always set, anything else means the pixel was drawn
+			count += (pixels[i] & 0x00ffffffu) != 0;
+		}
+		return count;
+	}
+
+	/**
+		A square rotated a little off the axes, so every edge is sloped.
+		Corners are in screen space with w = 1, colors and UVs per corner.
+	*/
+	struct quad {
+		vec4 vertices[4];
+		payload payloads[4];
+
+		quad(float centerX, float centerY, float side) {
+
+			const float angle = 0.3f;
+			const float corners[4][2] = { {-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}, {-0.5f, 0.5f} };
+			for (int i = 0; i < 4; ++i) {
+				float x = side * corners[i][0];
+				float y = side * corners[i][1];
+				vertices[i].vector = _mm_setr_ps(
+					centerX + x * cosf(angle) - y * sinf(angle), centerY + x * sinf(angle) + y * cosf(angle), 0.5f, 1.0f);
+				payloads[i].lump = _mm256_setr_ps(
+					0.5f + 0.5f * (i & 1), 0.5f + 0.25f * i, 1.0f,
+					corners[i][0] + 0.5f, corners[i][1] + 0.5f, 0.5f, 0.0f, 1.0f);
+			}
+		}
+
+		edgeTable edges() {
+			return { vertices, payloads, 4 };
+		}
+	};
+
+	/**
+		\returns a checkerboard texture, no texel of which is black
+	*/
+	texture make_texture(Engine& engine) {
+
+		const int size = 256;
+		std::vector<stbi_uc> texels(4 * size * size);
+		for (int y = 0; y < size; ++y) {
+			for (int x = 0; x < size; ++x) {
+				stbi_uc shade = ((x / 16 + y / 16) % 2) ? 255 : 64;
+				stbi_uc* texel = texels.data() + 4 * (size * y + x);
+				texel[0] = shade;
+				texel[1] = 255 - shade / 2;
+				texel[2] = shade;
+				texel[3] = 255;
+			}
+		}
+		return engine.convert_texture(texels.data(), size, size, textureLayout::packedTiled);
+	}
+
+	void clear_benchmarks(std::vector<benchmarkResult>& results) {
+
+		const int resolutions[][2] = { {640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160} };
+
+		for (const int* resolution : resolutions) {
+
+			int width = resolution[0];
+			int height = resolution[1];
+			renderTarget::MemoryTarget target;
+			Engine engine(width, height, &target);
+
+			std::string size = std::to_string(width) + "x" + std::to_string(height);
+			double pixels = (double)width * height;
+
+			results.push_back({ "clear_screen", "resolution", size, pixels,
+				time_calls([&]() { engine.clear_screen(0.1f, 0.2f, 0.3f); }) });
+			results.push_back({ "clear_screen_avx2", "resolution", size, pixels,
+				time_calls([&]() { engine.clear_screen_avx2(0.1f, 0.2f, 0.3f); }) });
+		}
+	}
+
+	void span_benchmarks(std::vector<benchmarkResult>& results) {
+
+		const int width = 1920, height = 1080;
+		renderTarget::MemoryTarget target;
+		Engine engine(width, height, &target);
+
+		//a span of each length on every row, starting at odd columns so the
+		//SIMD version has ragged ends to deal with
+		for (int length : { 8, 32, 128, 512, 1900 }) {
+
+			std::string size = std::to_string(length);
+			double pixels = (double)length * height;
+
+			results.push_back({ "draw_horizontal_line", "span", size, pixels,
+				time_calls([&]() {
+					for (int y = 0; y < height; ++y) {
+						engine.draw_horizontal_line(0.1f, 0.2f, 0.3f, 5 + y % 7, 5 + y % 7 + length, y);
+					}
+				}) });
+			results.push_back({ "draw_horizontal_line_avx2", "span", size, pixels,
+				time_calls([&]() {
+					for (int y = 0; y < height; ++y) {
+						engine.draw_horizontal_line_avx2(0.1f, 0.2f, 0.3f, 5 + y % 7, 5 + y % 7 + length, y);
+					}
+				}) });
+		}
+	}
+
+	void line_benchmarks(std::vector<benchmarkResult>& results) {
+
+		const int width = 640, height = 480;
+		renderTarget::MemoryTarget target;
+		Engine engine(width, height, &target);
+
+		//a star of lines out from the center, covering every octant
+		for (int length : { 16, 64, 200 }) {
+
+			std::vector<std::array<int, 4>> lines;
+			for (int i = 0; i < 16; ++i) {
+				float angle = 2.0f * pi * (i + 0.5f) / 16;
+				lines.push_back({ width / 2, height / 2,
+					width / 2 + (int)(length * cosf(angle)), height / 2 + (int)(length * sinf(angle)) });
+			}
+
+			std::string size = std::to_string(length);
+
+			auto naive = [&]() {
+				for (const std::array<int, 4>& line : lines) {
+					engine.draw_line_naive(1.0f, 1.0f, 1.0f, line[0], line[1], line[2], line[3]);
+				}
+			};
+			results.push_back({ "draw_line_naive", "length", size,
+				count_pixels(engine, target, width, height, naive), time_calls(naive) });
+
+			auto bresenham = [&]() {
+				for (const std::array<int, 4>& line : lines) {
+					engine.draw_line_bresenham(1.0f, 1.0f, 1.0f, line[0], line[1], line[2], line[3]);
+				}
+			};
+			results.push_back({ "draw_line_bresenham", "length", size,
+				count_pixels(engine, target, width, height, bresenham), time_calls(bresenham) });
+		}
+	}
+
+	void polygon_benchmarks(std::vector<benchmarkResult>& results) {
+
+		const int width = 640, height = 480;
+		renderTarget::MemoryTarget target;
+		Engine engine(width, height, &target);
+		texture tex = make_texture(engine);
+
+		for (int side : { 8, 32, 128, 320 }) {
+
+			quad polygon(width / 2.0f, height / 2.0f, (float)side);
+			std::string size = std::to_string(side);
+
+			auto flat = [&]() { engine.draw_polygon_flat(1.0f, 1.0f, 1.0f, polygon.edges()); };
+			auto blended = [&]() { engine.draw_polygon_blended(polygon.edges()); };
+			auto textured = [&]() { edgeTable edges = polygon.edges(); engine.draw_polygon_textured(edges, tex); };
+
+			results.push_back({ "draw_polygon_flat", "side", size,
+				count_pixels(engine, target, width, height, flat), time_calls(flat) });
+			results.push_back({ "draw_polygon_blended", "side", size,
+				count_pixels(engine, target, width, height, blended), time_calls(blended) });
+			results.push_back({ "draw_polygon_textured", "side", size,
+				count_pixels(engine, target, width, height, textured), time_calls(textured) });
+
+			engine.set_simd_spans(true);
+			results.push_back({ "draw_polygon_textured (avx2 spans)", "side", size,
+				count_pixels(engine, target, width, height, textured), time_calls(textured) });
+			engine.set_simd_spans(false);
+		}
+
+		engine.free_texture(tex);
+	}
+
+	void polygon_resolution_benchmarks(std::vector<benchmarkResult>& results) {
+
+		const int resolutions[][2] = { {640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160} };
+
+		for (const int* resolution : resolutions) {
+
+			int width = resolution[0];
+			int height = resolution[1];
+			renderTarget::MemoryTarget target;
+			Engine engine(width, height, &target);
+			texture tex = make_texture(engine);
+
+			//the same share of the screen at every resolution
+			quad polygon(width / 2.0f, height / 2.0f, 0.6f * height);
+			std::string size = std::to_string(width) + "x" + std::to_string(height);
+
+			auto flat = [&]() { engine.draw_polygon_flat(1.0f, 1.0f, 1.0f, polygon.edges()); };
+			auto textured = [&]() { edgeTable edges = polygon.edges(); engine.draw_polygon_textured(edges, tex); };
+
+			results.push_back({ "draw_polygon_flat", "resolution", size,
+				count_pixels(engine, target, width, height, flat), time_calls(flat) });
+			results.push_back({ "draw_polygon_textured", "resolution", size,
+				count_pixels(engine, target, width, height, textured), time_calls(textured) });
+
+			engine.free_texture(tex);
+		}
+	}
+
+	void transform_benchmarks(std::vector<benchmarkResult>& results) {
+
+		viewportTransform viewport = linalgMakeViewportTransform(640, 480);
+		mat4 model = linalgMulMat4Mat4(linalgMakeYRotation(30.0f), linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
+		mat4 transform = linalgMulMat4Mat4(model, linalgMakePerspectiveProjection(45.0f, 640.0f / 480.0f, 0.1f, 10.0f));
+
+		for (int vertexCount : { 1 << 10, 1 << 16 }) {
+
+			//a 64 x 64 grid of points, stacked in layers
+			std::vector<vec4> points(vertexCount), projectedPoints(vertexCount);
+			std::vector<float> x(vertexCount), y(vertexCount), z(vertexCount), w(vertexCount);
+			std::vector<float> screenX(vertexCount), screenY(vertexCount), depth(vertexCount), clipW(vertexCount);
+			for (int i = 0; i < vertexCount; ++i) {
+				points[i].vector = _mm_setr_ps(
+					(float)(i % 64) / 32.0f - 1.0f, (float)(i / 64 % 64) / 32.0f - 1.0f, (float)(i / 4096) / 8.0f - 1.0f, 1.0f);
+				x[i] = points[i].data[0];
+				y[i] = points[i].data[1];
+				z[i] = points[i].data[2];
+				w[i] = points[i].data[3];
+			}
+			vertexStream input = { x.data(), y.data(), z.data(), w.data(), vertexCount };
+			vertexStream output = { screenX.data(), screenY.data(), depth.data(), clipW.data(), vertexCount };
+
+			std::string size = std::to_string(vertexCount);
+
+			results.push_back({ "linalgMulMat4Vec4 + divide", "vertices", size, (double)vertexCount,
+				time_calls([&]() {
+					for (int i = 0; i < vertexCount; ++i) {
+						vec4 point = linalgMulMat4Vec4(transform, points[i]);
+						projectedPoints[i].data[0] = viewport.centerX + viewport.scaleX * point.data[0] / point.data[3];
+						projectedPoints[i].data[1] = viewport.centerY + viewport.scaleY * point.data[1] / point.data[3];
+						projectedPoints[i].data[2] = point.data[2] / point.data[3];
+						projectedPoints[i].data[3] = point.data[3];
+					}
+				}) });
+			results.push_back({ "linalgProjectVertexStream", "vertices", size, (double)vertexCount,
+				time_calls([&]() { linalgProjectVertexStream(&transform, &input, viewport, &output); }) });
+		}
+	}
+
+	void print_results(const std::vector<benchmarkResult>& results) {
+
+		std::cout << std::left << std::setw(38) << "primitive" << std::setw(12) << "sweep" << std::setw(12) << "size"
+			<< std::right << std::setw(14) << "ns/call" << std::setw(12) << "ns/pixel" << std::setw(10) << "GB/s" << std::endl;
+
+		std::cout << std::fixed;
+		for (const benchmarkResult& result : results) {
+			std::cout << std::left << std::setw(38) << result.primitive << std::setw(12) << result.sweep << std::setw(12) << result.size
+				<< std::right << std::setprecision(1) << std::setw(14) << result.nsPerCall
+				<< std::setprecision(3) << std::setw(12) << result.nsPerCall / result.pixels
+				<< std::setprecision(2) << std::setw(10) << 4.0 * result.pixels / result.nsPerCall << std::endl;
+		}
+	}
+
+	bool write_json(const std::string& filename, const std::vector<benchmarkResult>& results) {
+
+		std::ofstream file(filename);
+		if (!file) {
+			return false;
+		}
+
+		file << "[" << std::setprecision(6);
+		for (size_t i = 0; i < results.size(); ++i) {
+			const benchmarkResult& result = results[i];
+			file << (i ? ",\n " : "\n ") << "{\"primitive\": \"" << result.primitive << "\", \"sweep\": \"" << result.sweep
+				<< "\", \"size\": \"" << result.size << "\", \"pixels\": " << result.pixels
+				<< ", \"ns_per_call\": " << result.nsPerCall
+				<< ", \"ns_per_pixel\": " << result.nsPerCall / result.pixels
+				<< ", \"gb_per_second\": " << 4.0 * result.pixels / result.nsPerCall << "}";
+		}
+		file << "\n]\n";
+
+		return static_cast<bool>(file);
+	}
+}
+
+int main(int argc, char** argv) {
+
+	std::string jsonFile;
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--json") && i + 1 < argc) {
+			jsonFile = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--quick")) {
+			minBatchSeconds = 0.005;
+		}
+		else {
+			std::cout << "usage: " << argv[0] << " [--json results.json] [--quick]" << std::endl;
+			return 1;
+		}
+	}
+
+	vkLogging::Logger::get_logger()->set_debug_mode(false);
+
+	std::vector<benchmarkResult> results;
+	clear_benchmarks(results);
+	span_benchmarks(results);
+	line_benchmarks(results);
+	polygon_benchmarks(results);
+	polygon_resolution_benchmarks(results);
+	transform_benchmarks(results);
+
+	print_results(results);
+
+	if (!jsonFile.empty() && !write_json(jsonFile, results)) {
+		std::cout << "Couldn't write " << jsonFile << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
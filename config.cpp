@@ -1,3 +1,3 @@
-#include "config.h"
-#define STB_IMAGE_IMPLEMENTATION
+#include "config.h"
+#define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
\ No newline at end of file
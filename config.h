@@ -1,34 +1,36 @@
-#pragma once
-#include <vulkan/vulkan.hpp>
-
-#include <GLFW/glfw3.h>
-
-#include <iostream>
-#include <vector>
-#include <set>
-#include <string>
-#include <optional>
-
-#include <intrin.h>
-
-#include "stb_image.h"
-
-/**
-	Data structures used for creating buffers
-	and allocating memory
-*/
-struct BufferInputChunk {
-	size_t size;
-	vk::BufferUsageFlags usage;
-	vk::Device logicalDevice;
-	vk::PhysicalDevice physicalDevice;
-	vk::MemoryPropertyFlags memoryProperties;
-};
-
-/**
-	holds a vulkan buffer and memory allocation
-*/
-struct Buffer {
-	vk::Buffer buffer;
-	vk::DeviceMemory bufferMemory;
+#pragma once
+#include <vulkan/vulkan.hpp>
+
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <string>
+#include <optional>
+
+#include <intrin.h>
+
+#include "stb_image.h"
+
+/**
+	Data structures used for creating buffers
+	and allocating memory
+*/
+struct BufferInputChunk {
+	size_t size;
+	vk::BufferUsageFlags usage;
+	vk::Device logicalDevice;
+	vk::PhysicalDevice physicalDevice;
+	vk::MemoryPropertyFlags memoryProperties;
+	//wanted as well if any memory type has them, but not required
+	vk::MemoryPropertyFlags preferredProperties;
+};
+
+/**
+	holds a vulkan buffer and memory allocation
+*/
+struct Buffer {
+	vk::Buffer buffer;
+	vk::DeviceMemory bufferMemory;
 };
\ No newline at end of file
@@ -1,868 +1,1046 @@
-#include "app.h"
-#include "logging.h"
-#include <chrono>
-#include <math.h>
-#include "../linear_algebros.h"
-
-/**
-* Construct a new App.
-* 
-* @param width	the width of the window
-* @param height the height of the window
-* @param debug	whether to run the app with vulkan validation layers and extra print statements
-*/
-App::App(int width, int height, bool debug) {
-
-	vkLogging::Logger::get_logger()->set_debug_mode(debug);
-
-	build_glfw_window(width, height);
-
-	graphicsEngine = new Engine(width, height, window);
-
-	int tex_w, tex_h, channels;
-	stbi_uc* textureData = stbi_load("tex/floor.png", &tex_w, &tex_h, &channels, STBI_rgb_alpha);
-	tex = graphicsEngine->convert_texture(textureData, tex_w, tex_h);
-	free(textureData);
-
-}
-
-/**
-* Build the App's window (using glfw)
-* 
-* @param width		the width of the window
-* @param height		the height of the window
-* @param debugMode	whether to make extra print statements
-*/
-void App::build_glfw_window(int width, int height) {
-
-	std::stringstream message;
-
-	//initialize glfw
-	glfwInit();
-
-	//no default rendering client, we'll hook vulkan up
-	//to the window later
-	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-	//resizing breaks the swapchain, we'll disable it for now
-	glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
-
-	//GLFWwindow* glfwCreateWindow (int width, int height, const char *title, GLFWmonitor *monitor, GLFWwindow *share)
-	if (window = glfwCreateWindow(width, height, "ID Tech 12", nullptr, nullptr)) {
-		message << "Successfully made a glfw window called \"ID Tech 12\", width: " << width << ", height: " << height;
-		vkLogging::Logger::get_logger()->print(message.str());
-	}
-	else {
-		vkLogging::Logger::get_logger()->print("GLFW window creation failed");
-	}
-}
-
-/**
-* Start the App's main loop
-*/
-void App::run() {
-
-	while (!glfwWindowShouldClose(window)) {
-		glfwPollEvents();
-
-		//graphicsEngine->clear_screen(0.0, 0.0, 0.0);
-		graphicsEngine->clear_screen_avx2(0.0, 0.0, 0.0);
-		//lines_test();
-		//projection_test();
-		//backface_test();
-		//clipping_test();
-		//flat_shading_test();
-		//color_blending_test();
-		texture_test();
-		graphicsEngine->render();
-
-		calculateFrameRate();
-	}
-}
-
-void App::lines_test() {
-
-	if (trialCount < 1000) {
-		auto start = std::chrono::steady_clock::now();
-		//shallow, +ve slope
-		graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 20, 32, 420, 128);
-		//steep, +ve slope
-		graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 20, 32, 420, 628);
-		//shallow, -ve slope
-		graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 420, 32, 20, 128);
-		//steep, -ve slope
-		graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 420, 32, 20, 628);
-		auto end = std::chrono::steady_clock::now();
-		renderTimeA += 0.001 * std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-
-		start = std::chrono::steady_clock::now();
-		//shallow, +ve slope
-		graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 220, 32, 620, 128);
-		//steep, +ve slope
-		graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 220, 32, 620, 628);
-		//shallow, -ve slope
-		graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 620, 32, 220, 128);
-		//steep, -ve slope
-		graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 620, 32, 220, 628);
-		end = std::chrono::steady_clock::now();
-		renderTimeB += 0.001 * std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-		trialCount += 1;
-	}
-	else {
-		//shallow, +ve slope
-		graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 20, 32, 420, 128);
-		//steep, +ve slope
-		graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 20, 32, 420, 628);
-		//shallow, -ve slope
-		graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 420, 32, 20, 128);
-		//steep, -ve slope
-		graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 420, 32, 20, 628);
-
-		//shallow, +ve slope
-		graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 220, 32, 620, 128);
-		//steep, +ve slope
-		graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 220, 32, 620, 628);
-		//shallow, -ve slope
-		graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 620, 32, 220, 128);
-		//steep, -ve slope
-		graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 620, 32, 220, 628);
-
-		if (!logged) {
-			std::cout << "Naive render took " << (int)renderTimeA << " us." << std::endl;
-			std::cout << "Bresenham render took " << (int)renderTimeB << " us." << std::endl;
-			logged = true;
-		}
-	}
-}
-
-void App::projection_test() {
-	const int pointCount = 8;
-	vec4 vertices[pointCount] = {
-		{ 0.75f,  0.75f, -2.0f, 1.0f}, //0
-		{-0.75f,  0.75f, -2.0f, 1.0f}, //1
-		{-0.75f, -0.75f, -2.0f, 1.0f}, //2
-		{ 0.75f, -0.75f, -2.0f, 1.0f}, //3
-
-		{-0.75f,  0.75f, -3.5f, 1.0f}, //4
-		{ 0.75f,  0.75f, -3.5f, 1.0f}, //5
-		{ 0.75f, -0.75f, -3.5f, 1.0f}, //6
-		{-0.75f, -0.75f, -3.5f, 1.0f}, //7
-	};
-	vec4 transformedVertices[pointCount];
-
-	const int edgeCount = 12;
-	int edge_a[edgeCount] = {
-		0, 1, 2, 3,
-		4, 5, 6, 7,
-		1, 5, 3, 7
-	};
-
-	int edge_b[edgeCount] = {
-		1, 2, 3, 0,
-		5, 6, 7, 4,
-		4, 0, 6, 2
-	};
-
-	if (!logged) {
-		std::cout << "----    Cube Vertices (Initial):    ----" << std::endl;
-		for (int i = 0; i < pointCount; ++i) {
-			std::cout << "("
-				<< vertices[i].data[0] << ", "
-				<< vertices[i].data[1] << ", "
-				<< vertices[i].data[2] << ", "
-				<< vertices[i].data[3] << ")" << std::endl;
-		}
-	}
-
-	mat4 projection = linalgMakePerspectiveProjection(45.0f, (float)640 / 480, 0.1f, 10.0f);
-	for (int i = 0; i < pointCount; ++i) {
-		transformedVertices[i] = linalgMulMat4Vec4(projection, vertices[i]);
-		transformedVertices[i].data[0] = transformedVertices[i].data[0] / transformedVertices[i].data[3];
-		transformedVertices[i].data[1] = transformedVertices[i].data[1] / transformedVertices[i].data[3];
-		transformedVertices[i].data[2] = transformedVertices[i].data[2] / transformedVertices[i].data[3];
-	}
-
-	if (!logged) {
-		std::cout << "----    Cube Vertices (Projected):    ----" << std::endl;
-		for (int i = 0; i < pointCount; ++i) {
-			std::cout << "("
-				<< transformedVertices[i].data[0] << ", "
-				<< transformedVertices[i].data[1] << ", "
-				<< transformedVertices[i].data[2] << ", "
-				<< transformedVertices[i].data[3] << ")" << std::endl;
-		}
-	}
-
-	for (int i = 0; i < pointCount; ++i) {
-		transformedVertices[i].data[0] = 320 + 320 * transformedVertices[i].data[0];
-		transformedVertices[i].data[1] = 240 - 240 * transformedVertices[i].data[1];
-	}
-
-	if (!logged) {
-		std::cout << "----    Screen Coordinates:    ----" << std::endl;
-		for (int i = 0; i < pointCount; ++i) {
-			std::cout << "("
-				<< (int)transformedVertices[i].data[0] << ", "
-				<< (int)transformedVertices[i].data[1] << ")" << std::endl;
-		}
-	}
-
-	for (int i = 0; i < edgeCount; ++i) {
-		graphicsEngine->draw_line_bresenham(
-			1.0f, 1.0f, 1.0f,
-			transformedVertices[edge_a[i]].data[0], transformedVertices[edge_a[i]].data[1],
-			transformedVertices[edge_b[i]].data[0], transformedVertices[edge_b[i]].data[1]
-		);
-	}
-
-	logged = true;
-}
-
-void App::backface_test() {
-	const int pointCount = 8;
-	vec4 vertices[pointCount] = {
-		{ 0.75f,  0.75f,  0.75f, 1.0f}, //0
-		{-0.75f,  0.75f,  0.75f, 1.0f}, //1
-		{-0.75f, -0.75f,  0.75f, 1.0f}, //2
-		{ 0.75f, -0.75f,  0.75f, 1.0f}, //3
-
-		{-0.75f,  0.75f, -0.75f, 1.0f}, //4
-		{ 0.75f,  0.75f, -0.75f, 1.0f}, //5
-		{ 0.75f, -0.75f, -0.75f, 1.0f}, //6
-		{-0.75f, -0.75f, -0.75f, 1.0f}, //7
-	};
-	vec4 transformedVertices[pointCount];
-
-	const int planeCount = 6;
-	int plane_vertices[planeCount][4] = {
-		{0, 1, 2, 3}, //front
-		{1, 0, 5, 4}, //top
-		{3, 6, 5, 0}, //right
-		{7, 6, 3, 2}, //bottom
-		{1, 4, 7, 2}, //left
-		{4, 5, 6, 7}  //back
-	};
-
-	theta += 0.1f * frameTime / 16.6f;
-	if (theta > 360) {
-		theta -= 360;
-	}
-	mat4 model = linalgMakeZRotation(theta);
-	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
-	mat4 projection = linalgMakePerspectiveProjection(45.0f, (float)640 / 480, 0.1f, 10.0f);
-	mat4 finalTransform = linalgMulMat4Mat4(model, projection);
-	for (int i = 0; i < pointCount; ++i) {
-		transformedVertices[i] = linalgMulMat4Vec4(finalTransform, vertices[i]);
-		transformedVertices[i].data[0] = transformedVertices[i].data[0] / transformedVertices[i].data[3];
-		transformedVertices[i].data[1] = transformedVertices[i].data[1] / transformedVertices[i].data[3];
-		transformedVertices[i].data[2] = transformedVertices[i].data[2] / transformedVertices[i].data[3];
-	}
-
-	for (int i = 0; i < pointCount; ++i) {
-		transformedVertices[i].data[0] = 320 + 320 * transformedVertices[i].data[0];
-		transformedVertices[i].data[1] = 240 - 240 * transformedVertices[i].data[1];
-	}
-
-	for (int i = 0; i < planeCount; ++i) {
-
-		vec4 vertex_a = transformedVertices[plane_vertices[i][0]];
-		vec4 vertex_b = transformedVertices[plane_vertices[i][1]];
-		vec4 vertex_c = transformedVertices[plane_vertices[i][2]];
-
-		vec3 tangent = {
-			vertex_b.data[0] - vertex_a.data[0],
-			vertex_b.data[1] - vertex_a.data[1],
-			vertex_b.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 bitangent = {
-			vertex_c.data[0] - vertex_a.data[0],
-			vertex_c.data[1] - vertex_a.data[1],
-			vertex_c.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 normal = linalgCross(tangent, bitangent);
-
-		if (normal.data[2] > 0) {
-			continue;
-		}
-
-		for (int j = 0; j < 4; ++j) {
-
-			int x_a = (int)transformedVertices[plane_vertices[i][j]].data[0];
-			int y_a = (int)transformedVertices[plane_vertices[i][j]].data[1];
-
-			int x_b = (int)transformedVertices[plane_vertices[i][(j + 1) % 4]].data[0];
-			int y_b = (int)transformedVertices[plane_vertices[i][(j + 1) % 4]].data[1];
-			graphicsEngine->draw_line_bresenham(
-				1.0f, 1.0f, 1.0f,
-				x_a, y_a,
-				x_b, y_b
-			);
-		}
-	}
-
-	logged = true;
-}
-
-void App::clipping_test() {
-	const int pointCount = 8;
-	vec4 vertices[pointCount] = {
-		{ 0.75f,  0.75f,  0.75f, 1.0f}, //0
-		{-0.75f,  0.75f,  0.75f, 1.0f}, //1
-		{-0.75f, -0.75f,  0.75f, 1.0f}, //2
-		{ 0.75f, -0.75f,  0.75f, 1.0f}, //3
-
-		{-0.75f,  0.75f, -0.75f, 1.0f}, //4
-		{ 0.75f,  0.75f, -0.75f, 1.0f}, //5
-		{ 0.75f, -0.75f, -0.75f, 1.0f}, //6
-		{-0.75f, -0.75f, -0.75f, 1.0f}, //7
-	};
-	vec4 transformedVertices[pointCount];
-
-	const int planeCount = 6;
-	int plane_vertices[planeCount][4] = {
-		{0, 1, 2, 3}, //front
-		{1, 0, 5, 4}, //top
-		{3, 6, 5, 0}, //right
-		{7, 6, 3, 2}, //bottom
-		{1, 4, 7, 2}, //left
-		{4, 5, 6, 7}  //back
-	};
-
-	theta += 0.1f * frameTime / 16.6f;
-	if (theta > 360) {
-		theta -= 360;
-	}
-	mat4 model = linalgMakeZRotation(theta);
-	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 2.0f, -5.0f)));
-
-	float fovy = 45.0f;
-	float aspect = (float)640 / 480;
-	float near = 0.1f;
-	float far = 10.0f;
-	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
-	frustrum viewFrustrum = linalgMakeViewFrustrum(fovy, aspect, -near, -far);
-
-	for (int i = 0; i < pointCount; ++i) {
-		transformedVertices[i] = linalgMulMat4Vec4(model, vertices[i]);
-	}
-
-	for (int i = 0; i < planeCount; ++i) {
-
-		vec4 vertex_a = transformedVertices[plane_vertices[i][0]];
-		vec4 vertex_b = transformedVertices[plane_vertices[i][1]];
-		vec4 vertex_c = transformedVertices[plane_vertices[i][2]];
-
-		vec3 tangent = {
-			vertex_b.data[0] - vertex_a.data[0],
-			vertex_b.data[1] - vertex_a.data[1],
-			vertex_b.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 bitangent = {
-			vertex_c.data[0] - vertex_a.data[0],
-			vertex_c.data[1] - vertex_a.data[1],
-			vertex_c.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 normal = linalgCross(tangent, bitangent);
-		vec3 fragmentToViewer = linalgMakeVec3(
-			-vertex_a.data[0],
-			-vertex_a.data[1],
-			-vertex_a.data[2]
-		);
-
-		if (linalgDotVec3(normal, fragmentToViewer) < 0) {
-			continue;
-		}
-
-		edgeTable edges;
-		edges.vertexCount = 4;
-		edges.vertices = (vec4*)malloc(4 * sizeof(vec4));
-		for (int j = 0; j < 4; ++j) {
-			edges.vertices[j] = transformedVertices[plane_vertices[i][j]];
-		}
-		
-		edges = linalgFrustrumClipSimple(edges, viewFrustrum);
-
-		for (int j = 0; j < edges.vertexCount; ++j) {
-
-			vec4 point_a = linalgMulMat4Vec4(projection, edges.vertices[j]);
-			point_a.data[0] = point_a.data[0] / point_a.data[3];
-			point_a.data[1] = point_a.data[1] / point_a.data[3];
-
-			vec4 point_b = linalgMulMat4Vec4(projection, edges.vertices[(j + 1) % edges.vertexCount]);
-			point_b.data[0] = point_b.data[0] / point_b.data[3];
-			point_b.data[1] = point_b.data[1] / point_b.data[3];
-
-			int x_a = (int)(320 + 320 * point_a.data[0]);
-			int y_a = (int)(240 - 240 * point_a.data[1]);
-			int x_b = (int)(320 + 320 * point_b.data[0]);
-			int y_b = (int)(240 - 240 * point_b.data[1]);
-
-			graphicsEngine->draw_line_bresenham(
-				1.0f, 1.0f, 1.0f,
-				x_a, y_a,
-				x_b, y_b
-			);
-		}
-
-		free(edges.vertices);
-	}
-
-	logged = true;
-}
-
-void App::flat_shading_test() {
-	const int pointCount = 8;
-	vec4 vertices[pointCount] = {
-		{ 0.75f,  0.75f,  0.75f, 1.0f}, //0
-		{-0.75f,  0.75f,  0.75f, 1.0f}, //1
-		{-0.75f, -0.75f,  0.75f, 1.0f}, //2
-		{ 0.75f, -0.75f,  0.75f, 1.0f}, //3
-
-		{-0.75f,  0.75f, -0.75f, 1.0f}, //4
-		{ 0.75f,  0.75f, -0.75f, 1.0f}, //5
-		{ 0.75f, -0.75f, -0.75f, 1.0f}, //6
-		{-0.75f, -0.75f, -0.75f, 1.0f}, //7
-	};
-	vec4 transformedVertices[pointCount];
-
-	const int planeCount = 6;
-	int plane_vertices[planeCount][4] = {
-		{0, 1, 2, 3}, //front
-		{1, 0, 5, 4}, //top
-		{3, 6, 5, 0}, //right
-		{7, 6, 3, 2}, //bottom
-		{1, 4, 7, 2}, //left
-		{4, 5, 6, 7}  //back
-	};
-
-	theta += 0.1f * frameTime / 16.6f;
-	if (theta > 360) {
-		theta -= 360;
-	}
-	mat4 model = linalgMakeZRotation(theta);
-	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
-
-	float fovy = 45.0f;
-	float aspect = (float)640 / 480;
-	float near = 0.1f;
-	float far = 10.0f;
-	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
-	frustrum viewFrustrum = linalgMakeViewFrustrum(fovy, aspect, -near, -far);
-
-	for (int i = 0; i < pointCount; ++i) {
-		transformedVertices[i] = linalgMulMat4Vec4(model, vertices[i]);
-	}
-
-	for (int i = 0; i < planeCount; ++i) {
-
-		vec4 vertex_a = transformedVertices[plane_vertices[i][0]];
-		vec4 vertex_b = transformedVertices[plane_vertices[i][1]];
-		vec4 vertex_c = transformedVertices[plane_vertices[i][2]];
-
-		vec3 tangent = {
-			vertex_b.data[0] - vertex_a.data[0],
-			vertex_b.data[1] - vertex_a.data[1],
-			vertex_b.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 bitangent = {
-			vertex_c.data[0] - vertex_a.data[0],
-			vertex_c.data[1] - vertex_a.data[1],
-			vertex_c.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 normal = linalgNormalizeVec3(linalgCross(tangent, bitangent));
-		vec3 fragmentToViewer = linalgMakeVec3(
-			-vertex_a.data[0],
-			-vertex_a.data[1],
-			-vertex_a.data[2]
-		);
-
-		if (linalgDotVec3(normal, fragmentToViewer) < 0) {
-			continue;
-		}
-
-		edgeTable edges;
-		edges.vertexCount = 4;
-		edges.vertices = (vec4*)malloc(4 * sizeof(vec4));
-		for (int j = 0; j < 4; ++j) {
-			edges.vertices[j] = transformedVertices[plane_vertices[i][j]];
-		}
-
-		edges = linalgFrustrumClipSimple(edges, viewFrustrum);
-
-		for (int j = 0; j < edges.vertexCount; ++j) {
-
-			vec4 point = linalgMulMat4Vec4(projection, edges.vertices[j]);
-			point.data[0] = point.data[0] / point.data[3];
-			point.data[1] = point.data[1] / point.data[3];
-
-			edges.vertices[j].data[0] = (int)(320 + 320 * point.data[0]);
-			edges.vertices[j].data[1] = (int)(240 - 240 * point.data[1]);
-		}
-
-		vec3 torch = { 0.0f, 0.0f, 1.0f, 0.0f };
-		torch = linalgNormalizeVec3(torch);
-		vec3 diffuseColor = { 1.0f, 1.0f, 1.0f, 0.0f };
-		diffuseColor = linalgMulVec3(diffuseColor, std::max(0.0f, linalgDotVec3(normal, torch)));
-
-		graphicsEngine->draw_polygon_flat(
-			diffuseColor.data[0], diffuseColor.data[1], diffuseColor.data[2],
-			edges
-		);
-
-		free(edges.vertices);
-	}
-
-	logged = true;
-}
-
-void App::color_blending_test() {
-	const int pointCount = 8;
-	vec4 vertices[pointCount] = {
-		{ 0.75f,  0.75f,  0.75f, 1.0f}, //0
-		{-0.75f,  0.75f,  0.75f, 1.0f}, //1
-		{-0.75f, -0.75f,  0.75f, 1.0f}, //2
-		{ 0.75f, -0.75f,  0.75f, 1.0f}, //3
-
-		{-0.75f,  0.75f, -0.75f, 1.0f}, //4
-		{ 0.75f,  0.75f, -0.75f, 1.0f}, //5
-		{ 0.75f, -0.75f, -0.75f, 1.0f}, //6
-		{-0.75f, -0.75f, -0.75f, 1.0f}, //7
-	};
-
-	payload attributes[pointCount] = {
-		{0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
-		{1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
-		{0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
-		{1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
-
-		{0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
-		{1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
-		{0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
-		{1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
-	};
-
-	vec4 transformedVertices[pointCount];
-
-	const int planeCount = 6;
-	int plane_vertices[planeCount][4] = {
-		{0, 1, 2, 3}, //front
-		{1, 0, 5, 4}, //top
-		{3, 6, 5, 0}, //right
-		{7, 6, 3, 2}, //bottom
-		{1, 4, 7, 2}, //left
-		{4, 5, 6, 7}  //back
-	};
-
-	theta += 0.1f * frameTime / 16.6f;
-	if (theta > 360) {
-		theta -= 360;
-	}
-	mat4 model = linalgMakeZRotation(theta);
-	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
-
-	float fovy = 45.0f;
-	float aspect = (float)640 / 480;
-	float near = 0.1f;
-	float far = 10.0f;
-	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
-	frustrum viewFrustrum = linalgMakeViewFrustrum(fovy, aspect, -near, -far);
-
-	for (int i = 0; i < pointCount; ++i) {
-		transformedVertices[i] = linalgMulMat4Vec4(model, vertices[i]);
-	}
-
-	for (int i = 0; i < planeCount; ++i) {
-
-		vec4 vertex_a = transformedVertices[plane_vertices[i][0]];
-		vec4 vertex_b = transformedVertices[plane_vertices[i][1]];
-		vec4 vertex_c = transformedVertices[plane_vertices[i][2]];
-
-		vec3 tangent = {
-			vertex_b.data[0] - vertex_a.data[0],
-			vertex_b.data[1] - vertex_a.data[1],
-			vertex_b.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 bitangent = {
-			vertex_c.data[0] - vertex_a.data[0],
-			vertex_c.data[1] - vertex_a.data[1],
-			vertex_c.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 normal = linalgNormalizeVec3(linalgCross(tangent, bitangent));
-		vec3 fragmentToViewer = linalgMakeVec3(
-			-vertex_a.data[0],
-			-vertex_a.data[1],
-			-vertex_a.data[2]
-		);
-
-		if (linalgDotVec3(normal, fragmentToViewer) < 0) {
-			continue;
-		}
-
-		edgeTable edges;
-		edges.vertexCount = 4;
-		edges.vertices = (vec4*)malloc(4 * sizeof(vec4));
-		edges.payloads = (payload*)malloc(4 * sizeof(payload));
-		for (int j = 0; j < 4; ++j) {
-			edges.vertices[j] = transformedVertices[plane_vertices[i][j]];
-
-			payload attribute = attributes[plane_vertices[i][j]];
-			vec3 torch = { 0.0f, 0.0f, 1.0f, 0.0f };
-			torch = linalgNormalizeVec3(torch);
-			vec3 diffuseColor = { attribute.data[0], attribute.data[1], attribute.data[2], 0.0f};
-			diffuseColor = linalgMulVec3(diffuseColor, std::max(0.0f, linalgDotVec3(normal, torch)));
-			attribute.data[0] = diffuseColor.data[0];
-			attribute.data[1] = diffuseColor.data[1];
-			attribute.data[2] = diffuseColor.data[2];
-
-			edges.payloads[j] = attribute;
-		}
-
-		edges = linalgFrustrumClip(edges, viewFrustrum);
-
-		for (int j = 0; j < edges.vertexCount; ++j) {
-
-			vec4 point = linalgMulMat4Vec4(projection, edges.vertices[j]);
-			point.data[0] = point.data[0] / point.data[3];
-			point.data[1] = point.data[1] / point.data[3];
-
-			edges.vertices[j].data[0] = (int)(320 + 320 * point.data[0]);
-			edges.vertices[j].data[1] = (int)(240 - 240 * point.data[1]);
-		}
-
-		graphicsEngine->draw_polygon_blended(edges);
-
-		free(edges.vertices);
-		free(edges.payloads);
-	}
-
-	logged = true;
-}
-
-void App::texture_test() {
-
-	/*
-	int width, height, channels;
-	stbi_uc* textureData = stbi_load("tex/test.png", &width, &height, &channels, STBI_rgb_alpha);
-	if (!logged) {
-		std::cout << "Image loaded, width: " << width << ", height: " << height << ", channels: " << channels << std::endl;
-
-		std::cout << "----    texture data (raw):    ----" << std::endl;
-		for (int y = 0; y < height; ++y) {
-			for (int x = 0; x < width; ++x) {
-				std::cout
-					<< "(" << (float)textureData[4 * (width * y + x)]
-					<< ", " << (float)textureData[4 * (width * y + x) + 1]
-					<< ", " << (float)textureData[4 * (width * y + x) + 2]
-					<< ", " << (float)textureData[4 * (width * y + x) + 3] << ") ";
-			}
-			std::cout << std::endl;
-		}
-	}
-	logged = true;
-	free(textureData);
-	*/
-
-	const int pointCount = 16;
-	vec4 vertices[pointCount] = {
-		//front
-		{0.75f, -0.75f, -0.75f, 1.0f}, //0
-		{-0.75f, -0.75f, -0.75f, 1.0f}, //1
-		{-0.75f,  0.75f, -0.75f, 1.0f}, //2
-		{0.75f,  0.75f, -0.75f, 1.0f}, //3
-
-		//back
-		{-0.75f, -0.75f,  0.75f, 1.0f}, //4
-		{0.75f, -0.75f,  0.75f, 1.0f}, //5
-		{0.75f,  0.75f,  0.75f, 1.0f}, //6
-		{-0.75f,  0.75f,  0.75f, 1.0f}, //7
-
-		//top
-		{-0.75f, -0.75f, -0.75f, 1.0f}, //1 (8)
-		{0.75f, -0.75f, -0.75f, 1.0f}, //0 (9)
-		{0.75f, -0.75f,  0.75f, 1.0f}, //5 (10)
-		{-0.75f, -0.75f,  0.75f, 1.0f}, //4 (11)
-
-		//bottom
-		{-0.75f,  0.75f, -0.75f, 1.0f}, //2 (12)
-		{-0.75f,  0.75f,  0.75f, 1.0f}, //7 (13)
-		{0.75f,  0.75f,  0.75f, 1.0f}, //6 (14)
-		{0.75f,  0.75f, -0.75f, 1.0f}, //3 (15)
-	};
-
-	payload attributes[pointCount] = {
-		{0.5f, 0.5f, 0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //0
-		{1.0f, 0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //1
-		{0.5f, 1.0f, 0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //2
-		{1.0f, 1.0f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //3
-
-		{0.5f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //4
-		{1.0f, 0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //5
-		{0.5f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //6
-		{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //7
-
-		{1.0f, 0.5f, 0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //1 (8)
-		{0.5f, 0.5f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //0 (9)
-		{1.0f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //5 (10)
-		{0.5f, 0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //4 (11)
-
-		{0.5f, 1.0f, 0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //2 (12)
-		{1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //7 (13)
-		{0.5f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //6 (14)
-		{1.0f, 1.0f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //3 (15)
-	};
-
-	vec4 transformedVertices[pointCount];
-
-	const int planeCount = 6;
-	int plane_vertices[planeCount][4] = {
-		{0, 1, 2, 3}, //front
-		{8, 9, 10, 11}, //top
-		{3, 6, 5, 0}, //right
-		{12, 13, 14, 15}, //bottom
-		{1, 4, 7, 2}, //left
-		{4, 5, 6, 7}  //back
-	};
-
-	theta += 0.1f * frameTime / 16.6f;
-	if (theta > 360) {
-		theta -= 360;
-	}
-	mat4 model = linalgMakeZRotation(theta);
-	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
-	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
-
-	float fovy = 45.0f;
-	float aspect = (float)640 / 480;
-	float near = 0.1f;
-	float far = 10.0f;
-	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
-	frustrum viewFrustrum = linalgMakeViewFrustrum(fovy, aspect, -near, -far);
-
-	for (int i = 0; i < pointCount; ++i) {
-		transformedVertices[i] = linalgMulMat4Vec4(model, vertices[i]);
-	}
-
-	for (int i = 0; i < planeCount; ++i) {
-
-		vec4 vertex_a = transformedVertices[plane_vertices[i][0]];
-		vec4 vertex_b = transformedVertices[plane_vertices[i][1]];
-		vec4 vertex_c = transformedVertices[plane_vertices[i][2]];
-
-		vec3 tangent = {
-			vertex_b.data[0] - vertex_a.data[0],
-			vertex_b.data[1] - vertex_a.data[1],
-			vertex_b.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 bitangent = {
-			vertex_c.data[0] - vertex_a.data[0],
-			vertex_c.data[1] - vertex_a.data[1],
-			vertex_c.data[2] - vertex_a.data[2],
-			0.0f
-		};
-
-		vec3 normal = linalgNormalizeVec3(linalgCross(tangent, bitangent));
-		vec3 fragmentToViewer = linalgMakeVec3(
-			-vertex_a.data[0],
-			-vertex_a.data[1],
-			-vertex_a.data[2]
-		);
-
-		if (linalgDotVec3(normal, fragmentToViewer) < 0) {
-			continue;
-		}
-
-		edgeTable edges;
-		edges.vertexCount = 4;
-		edges.vertices = (vec4*)malloc(4 * sizeof(vec4));
-		edges.payloads = (payload*)malloc(4 * sizeof(payload));
-		for (int j = 0; j < 4; ++j) {
-			edges.vertices[j] = transformedVertices[plane_vertices[i][j]];
-
-			payload attribute = attributes[plane_vertices[i][j]];
-			vec3 torch = { 0.0f, 0.0f, 1.0f, 0.0f };
-			torch = linalgNormalizeVec3(torch);
-			vec3 diffuseColor = { attribute.data[0], attribute.data[1], attribute.data[2], 0.0f };
-			diffuseColor = linalgMulVec3(diffuseColor, std::max(0.0f, linalgDotVec3(normal, torch)));
-			attribute.data[0] = diffuseColor.data[0];
-			attribute.data[1] = diffuseColor.data[1];
-			attribute.data[2] = diffuseColor.data[2];
-
-			edges.payloads[j] = attribute;
-		}
-
-		edges = linalgFrustrumClip(edges, viewFrustrum);
-
-		for (int j = 0; j < edges.vertexCount; ++j) {
-
-			vec4 point = linalgMulMat4Vec4(projection, edges.vertices[j]);
-			point.data[0] = point.data[0] / point.data[3];
-			point.data[1] = point.data[1] / point.data[3];
-
-			edges.vertices[j].data[0] = (int)(320 + 320 * point.data[0]);
-			edges.vertices[j].data[1] = (int)(240 - 240 * point.data[1]);
-		}
-
-		graphicsEngine->draw_polygon_textured(edges, tex);
-
-		free(edges.vertices);
-		free(edges.payloads);
-	}
-
-	logged = true;
-}
-
-/**
-* Calculates the App's framerate and updates the window title
-*/
-void App::calculateFrameRate() {
-	currentTime = glfwGetTime();
-	double delta = currentTime - lastTime;
-
-	if (delta >= 1) {
-		int framerate{ std::max(1, int(numFrames / delta)) };
-		std::stringstream title;
-		title << "Running at " << framerate << " fps.";
-		glfwSetWindowTitle(window, title.str().c_str());
-		lastTime = currentTime;
-		numFrames = -1;
-		frameTime = float(1000.0 / framerate);
-	}
-
-	++numFrames;
-}
-
-/**
-* App destructor.
-*/
-App::~App() {
-	delete graphicsEngine;
-	free(tex.r);
-	free(tex.b);
-	free(tex.g);
+#include "app.h"
+#include "logging.h"
+#include "profiler.h"
+#include <math.h>
+#include "../linear_algebros.h"
+
+/**
+* Construct a new App.
+* 
+* @param width	the width of the window
+* @param height the height of the window
+* @param debug	whether to run the app with vulkan validation layers and extra print statements
+*/
+App::App(int width, int height, bool debug) {
+
+	vkLogging::Logger::get_logger()->set_debug_mode(debug);
+
+	build_glfw_window(width, height);
+
+	graphicsEngine = new Engine(width, height, window, presentPolicy::maxThroughput);
+	build_scenes();
+	graphicsEngine->set_pipelined(true);
+
+}
+
+/**
+* Construct an App with no window, which draws into a render target instead.
+* Nothing moves unless set_theta is called, since no time passes between frames.
+* 
+* @param width	the width of the frames
+* @param height the height of the frames
+* @param target	where finished frames go
+*/
+App::App(int width, int height, renderTarget::RenderTarget* target) {
+
+	vkLogging::Logger::get_logger()->set_debug_mode(false);
+
+	window = nullptr;
+	graphicsEngine = new Engine(width, height, target);
+	build_scenes();
+
+}
+
+/**
+* Set up everything the tests draw with, and the engine settings they're drawn under.
+*/
+void App::build_scenes() {
+
+	viewport = graphicsEngine->get_viewport();
+	build_meshes();
+	graphicsEngine->set_tile_binning(true);
+	graphicsEngine->set_perspective_mode(perspectiveMode::subdivide16);
+	graphicsEngine->set_depth_test(true);
+	graphicsEngine->set_texture_filter(textureFilter::trilinear);
+	graphicsEngine->set_simd_spans(true);
+
+	int tex_w, tex_h, channels;
+	stbi_uc* textureData = stbi_load("tex/floor.png", &tex_w, &tex_h, &channels, STBI_rgb_alpha);
+	tex = graphicsEngine->convert_texture(textureData, tex_w, tex_h, textureLayout::packedTiled);
+	free(textureData);
+}
+
+/**
+* Build the meshes drawn by the tests.
+*/
+void App::build_meshes() {
+
+	//a cube with a color at each corner
+	{
+		const int pointCount = 8;
+		vec4 vertices[pointCount] = {
+			{ 0.75f,  0.75f,  0.75f, 1.0f}, //0
+			{-0.75f,  0.75f,  0.75f, 1.0f}, //1
+			{-0.75f, -0.75f,  0.75f, 1.0f}, //2
+			{ 0.75f, -0.75f,  0.75f, 1.0f}, //3
+
+			{-0.75f,  0.75f, -0.75f, 1.0f}, //4
+			{ 0.75f,  0.75f, -0.75f, 1.0f}, //5
+			{ 0.75f, -0.75f, -0.75f, 1.0f}, //6
+			{-0.75f, -0.75f, -0.75f, 1.0f}, //7
+		};
+
+		payload attributes[pointCount] = {
+			{0.5f, 0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+			{1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+			{0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+			{1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+
+			{0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+			{1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+			{0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+			{1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f},
+		};
+
+		const int planeCount = 6;
+		int plane_vertices[planeCount][4] = {
+			{0, 1, 2, 3}, //front
+			{1, 0, 5, 4}, //top
+			{3, 6, 5, 0}, //right
+			{7, 6, 3, 2}, //bottom
+			{1, 4, 7, 2}, //left
+			{4, 5, 6, 7}  //back
+		};
+
+		for (int i = 0; i < pointCount; ++i) {
+			cube.add_vertex(vertices[i], attributes[i]);
+		}
+		for (int i = 0; i < planeCount; ++i) {
+			cube.add_polygon(plane_vertices[i]);
+		}
+	}
+
+	//a cube with texture coordinates, which needs some corners duplicated
+	{
+		const int pointCount = 16;
+		vec4 vertices[pointCount] = {
+			//front
+			{0.75f, -0.75f, -0.75f, 1.0f}, //0
+			{-0.75f, -0.75f, -0.75f, 1.0f}, //1
+			{-0.75f,  0.75f, -0.75f, 1.0f}, //2
+			{0.75f,  0.75f, -0.75f, 1.0f}, //3
+
+			//back
+			{-0.75f, -0.75f,  0.75f, 1.0f}, //4
+			{0.75f, -0.75f,  0.75f, 1.0f}, //5
+			{0.75f,  0.75f,  0.75f, 1.0f}, //6
+			{-0.75f,  0.75f,  0.75f, 1.0f}, //7
+
+			//top
+			{-0.75f, -0.75f, -0.75f, 1.0f}, //1 (8)
+			{0.75f, -0.75f, -0.75f, 1.0f}, //0 (9)
+			{0.75f, -0.75f,  0.75f, 1.0f}, //5 (10)
+			{-0.75f, -0.75f,  0.75f, 1.0f}, //4 (11)
+
+			//bottom
+			{-0.75f,  0.75f, -0.75f, 1.0f}, //2 (12)
+			{-0.75f,  0.75f,  0.75f, 1.0f}, //7 (13)
+			{0.75f,  0.75f,  0.75f, 1.0f}, //6 (14)
+			{0.75f,  0.75f, -0.75f, 1.0f}, //3 (15)
+		};
+
+		payload attributes[pointCount] = {
+			{0.5f, 0.5f, 0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //0
+			{1.0f, 0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //1
+			{0.5f, 1.0f, 0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //2
+			{1.0f, 1.0f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //3
+
+			{0.5f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //4
+			{1.0f, 0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //5
+			{0.5f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //6
+			{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //7
+
+			{1.0f, 0.5f, 0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //1 (8)
+			{0.5f, 0.5f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //0 (9)
+			{1.0f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //5 (10)
+			{0.5f, 0.5f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //4 (11)
+
+			{0.5f, 1.0f, 0.5f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //2 (12)
+			{1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //7 (13)
+			{0.5f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f}, //6 (14)
+			{1.0f, 1.0f, 0.5f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}, //3 (15)
+		};
+
+		const int planeCount = 6;
+		int plane_vertices[planeCount][4] = {
+			{0, 1, 2, 3}, //front
+			{8, 9, 10, 11}, //top
+			{3, 6, 5, 0}, //right
+			{12, 13, 14, 15}, //bottom
+			{1, 4, 7, 2}, //left
+			{4, 5, 6, 7}  //back
+		};
+
+		for (int i = 0; i < pointCount; ++i) {
+			texturedCube.add_vertex(vertices[i], attributes[i]);
+		}
+		for (int i = 0; i < planeCount; ++i) {
+			texturedCube.add_polygon(plane_vertices[i]);
+		}
+	}
+}
+
+/**
+* Build the App's window (using glfw)
+* 
+* @param width		the width of the window
+* @param height		the height of the window
+* @param debugMode	whether to make extra print statements
+*/
+void App::build_glfw_window(int width, int height) {
+
+	std::stringstream message;
+
+	//initialize glfw
+	glfwInit();
+
+	//no default rendering client, we'll hook vulkan up
+	//to the window later
+	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+	//resizing breaks the swapchain, we'll disable it for now
+	glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+
+	//GLFWwindow* glfwCreateWindow (int width, int height, const char *title, GLFWmonitor *monitor, GLFWwindow *share)
+	if (window = glfwCreateWindow(width, height, "ID Tech 12", nullptr, nullptr)) {
+		message << "Successfully made a glfw window called \"ID Tech 12\", width: " << width << ", height: " << height;
+		vkLogging::Logger::get_logger()->print(message.str());
+	}
+	else {
+		vkLogging::Logger::get_logger()->print("GLFW window creation failed");
+	}
+}
+
+/**
+* Start the App's main loop
+*/
+void App::run() {
+
+	while (!glfwWindowShouldClose(window)) {
+		glfwPollEvents();
+
+		//the window may have been resized since the last frame
+		viewport = graphicsEngine->get_viewport();
+
+		//graphicsEngine->clear_screen(0.0, 0.0, 0.0);
+		graphicsEngine->clear_screen_avx2(0.0, 0.0, 0.0);
+		//lines_test();
+		//projection_test();
+		//backface_test();
+		//clipping_test();
+		//flat_shading_test();
+		//color_blending_test();
+		if (importedMesh.polygonCount > 0) {
+			model_test();
+		}
+		else {
+			texture_test();
+		}
+		graphicsEngine->render();
+
+		calculateFrameRate();
+	}
+}
+
+/**
+* Draw a single frame of one of the tests, the way run() does.
+* 
+* @param test	the test to draw, eg. &App::texture_test
+*/
+void App::draw_frame(void (App::*test)()) {
+
+	viewport = graphicsEngine->get_viewport();
+	culledPolygons = 0;
+	graphicsEngine->clear_screen_avx2(0.0, 0.0, 0.0);
+	(this->*test)();
+	graphicsEngine->render();
+}
+
+/**
+* Pin the rotation the tests draw their models at (in degrees).
+*/
+void App::set_theta(float theta) {
+
+	this->theta = theta;
+}
+
+/**
+* Draw without the engine's fast paths, binning and SIMD spans, so their
+* output can be checked against the straightforward path's.
+*/
+void App::use_reference_paths() {
+
+	graphicsEngine->set_tile_binning(false);
+	graphicsEngine->set_simd_spans(false);
+}
+
+/**
+* Have the engine track dirty tiles, so each frame after the first only hands
+* over the tiles which changed.
+*/
+void App::use_dirty_tracking() {
+
+	graphicsEngine->set_dirty_tracking(true);
+}
+
+/**
+* Have the engine count fragments drawn over pixels already covered in the
+* same frame. The tests cull back faces, so their cubes should never overdraw.
+*/
+void App::count_overdraw() {
+
+	graphicsEngine->set_overdraw_counting(true);
+}
+
+/**
+* Get the overdraw in the last frame drawn, once count_overdraw has been called.
+*/
+uint64_t App::get_overdraw_count() {
+
+	return graphicsEngine->get_overdraw_count();
+}
+
+/**
+* Get how many polygons the last frame drawn skipped as hidden, before clipping them.
+*/
+uint64_t App::get_culled_polygon_count() {
+
+	return culledPolygons;
+}
+
+/**
+* Load a model for model_test to draw, which run() then draws instead of the
+* textured cube. An OBJ file is converted to a mesh file next to it first,
+* anything else is mapped as a mesh file as it is.
+*
+* @param filename	the OBJ or mesh file to load
+* @returns			whether the model was loaded
+*/
+bool App::load_model(const char* filename) {
+
+	std::string meshFilename = filename;
+	size_t length = meshFilename.size();
+	if (length > 4 && meshFilename.compare(length - 4, 4, ".obj") == 0) {
+		meshFilename.replace(length - 4, 4, ".mesh");
+		if (!geometry::convert_obj(filename, meshFilename.c_str())) {
+			return false;
+		}
+	}
+
+	if (!importedMesh.open(meshFilename.c_str())) {
+		return false;
+	}
+
+	//centered on its bounding box, and far enough away that its bounding
+	//sphere looks as big as the cubes' do
+	const vertexStream& positions = importedMesh.positions;
+	float low[3] = { INFINITY, INFINITY, INFINITY };
+	float high[3] = { -INFINITY, -INFINITY, -INFINITY };
+	for (int i = 0; i < positions.count; ++i) {
+		const float point[3] = { positions.x[i], positions.y[i], positions.z[i] };
+		for (int axis = 0; axis < 3; ++axis) {
+			low[axis] = std::min(low[axis], point[axis]);
+			high[axis] = std::max(high[axis], point[axis]);
+		}
+	}
+	importedCenter = linalgMakeVec3(0.5f * (low[0] + high[0]), 0.5f * (low[1] + high[1]), 0.5f * (low[2] + high[2]));
+
+	float radius = 0.0f;
+	for (int i = 0; i < positions.count; ++i) {
+		vec3 offset = linalgSubVec3(linalgMakeVec3(positions.x[i], positions.y[i], positions.z[i]), importedCenter);
+		radius = std::max(radius, sqrtf(linalgDotVec3(offset, offset)));
+	}
+	const float cubeRadius = 0.75f * sqrtf(3.0f);
+	importedDistance = radius > 0.0f ? 5.0f * radius / cubeRadius : 5.0f;
+
+	return true;
+}
+
+/**
+* Draw a line in each direction with both algorithms, side by side.
+* Timings live in the benchmark project.
+*/
+void App::lines_test() {
+
+	//shallow, +ve slope
+	graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 20, 32, 420, 128);
+	//steep, +ve slope
+	graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 20, 32, 420, 628);
+	//shallow, -ve slope
+	graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 420, 32, 20, 128);
+	//steep, -ve slope
+	graphicsEngine->draw_line_naive(0.0f, 1.0f, 1.0f, 420, 32, 20, 628);
+
+	//shallow, +ve slope
+	graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 220, 32, 620, 128);
+	//steep, +ve slope
+	graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 220, 32, 620, 628);
+	//shallow, -ve slope
+	graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 620, 32, 220, 128);
+	//steep, -ve slope
+	graphicsEngine->draw_line_bresenham(1.0f, 0.0f, 1.0f, 620, 32, 220, 628);
+}
+
+void App::projection_test() {
+	const int pointCount = 8;
+	vec4 vertices[pointCount] = {
+		{ 0.75f,  0.75f, -2.0f, 1.0f}, //0
+		{-0.75f,  0.75f, -2.0f, 1.0f}, //1
+		{-0.75f, -0.75f, -2.0f, 1.0f}, //2
+		{ 0.75f, -0.75f, -2.0f, 1.0f}, //3
+
+		{-0.75f,  0.75f, -3.5f, 1.0f}, //4
+		{ 0.75f,  0.75f, -3.5f, 1.0f}, //5
+		{ 0.75f, -0.75f, -3.5f, 1.0f}, //6
+		{-0.75f, -0.75f, -3.5f, 1.0f}, //7
+	};
+	vec4 transformedVertices[pointCount];
+
+	const int edgeCount = 12;
+	int edge_a[edgeCount] = {
+		0, 1, 2, 3,
+		4, 5, 6, 7,
+		1, 5, 3, 7
+	};
+
+	int edge_b[edgeCount] = {
+		1, 2, 3, 0,
+		5, 6, 7, 4,
+		4, 0, 6, 2
+	};
+
+	if (!logged) {
+		std::cout << "----    Cube Vertices (Initial):    ----" << std::endl;
+		for (int i = 0; i < pointCount; ++i) {
+			std::cout << "("
+				<< vertices[i].data[0] << ", "
+				<< vertices[i].data[1] << ", "
+				<< vertices[i].data[2] << ", "
+				<< vertices[i].data[3] << ")" << std::endl;
+		}
+	}
+
+	mat4 projection = linalgMakePerspectiveProjection(45.0f, viewport.centerX / viewport.centerY, 0.1f, 10.0f);
+	for (int i = 0; i < pointCount; ++i) {
+		transformedVertices[i] = linalgMulMat4Vec4(projection, vertices[i]);
+		transformedVertices[i].data[0] = transformedVertices[i].data[0] / transformedVertices[i].data[3];
+		transformedVertices[i].data[1] = transformedVertices[i].data[1] / transformedVertices[i].data[3];
+		transformedVertices[i].data[2] = transformedVertices[i].data[2] / transformedVertices[i].data[3];
+	}
+
+	if (!logged) {
+		std::cout << "----    Cube Vertices (Projected):    ----" << std::endl;
+		for (int i = 0; i < pointCount; ++i) {
+			std::cout << "("
+				<< transformedVertices[i].data[0] << ", "
+				<< transformedVertices[i].data[1] << ", "
+				<< transformedVertices[i].data[2] << ", "
+				<< transformedVertices[i].data[3] << ")" << std::endl;
+		}
+	}
+
+	for (int i = 0; i < pointCount; ++i) {
+		transformedVertices[i].data[0] = viewport.centerX + viewport.scaleX * transformedVertices[i].data[0];
+		transformedVertices[i].data[1] = viewport.centerY + viewport.scaleY * transformedVertices[i].data[1];
+	}
+
+	if (!logged) {
+		std::cout << "----    Screen Coordinates:    ----" << std::endl;
+		for (int i = 0; i < pointCount; ++i) {
+			std::cout << "("
+				<< (int)transformedVertices[i].data[0] << ", "
+				<< (int)transformedVertices[i].data[1] << ")" << std::endl;
+		}
+	}
+
+	for (int i = 0; i < edgeCount; ++i) {
+		graphicsEngine->draw_line_bresenham(
+			1.0f, 1.0f, 1.0f,
+			transformedVertices[edge_a[i]].data[0], transformedVertices[edge_a[i]].data[1],
+			transformedVertices[edge_b[i]].data[0], transformedVertices[edge_b[i]].data[1]
+		);
+	}
+
+	logged = true;
+}
+
+void App::backface_test() {
+	const int pointCount = 8;
+	vec4 vertices[pointCount] = {
+		{ 0.75f,  0.75f,  0.75f, 1.0f}, //0
+		{-0.75f,  0.75f,  0.75f, 1.0f}, //1
+		{-0.75f, -0.75f,  0.75f, 1.0f}, //2
+		{ 0.75f, -0.75f,  0.75f, 1.0f}, //3
+
+		{-0.75f,  0.75f, -0.75f, 1.0f}, //4
+		{ 0.75f,  0.75f, -0.75f, 1.0f}, //5
+		{ 0.75f, -0.75f, -0.75f, 1.0f}, //6
+		{-0.75f, -0.75f, -0.75f, 1.0f}, //7
+	};
+	vec4 transformedVertices[pointCount];
+
+	const int planeCount = 6;
+	int plane_vertices[planeCount][4] = {
+		{0, 1, 2, 3}, //front
+		{1, 0, 5, 4}, //top
+		{3, 6, 5, 0}, //right
+		{7, 6, 3, 2}, //bottom
+		{1, 4, 7, 2}, //left
+		{4, 5, 6, 7}  //back
+	};
+
+	theta += 0.1f * frameTime / 16.6f;
+	if (theta > 360) {
+		theta -= 360;
+	}
+	mat4 model = linalgMakeZRotation(theta);
+	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
+	mat4 projection = linalgMakePerspectiveProjection(45.0f, viewport.centerX / viewport.centerY, 0.1f, 10.0f);
+	mat4 finalTransform = linalgMulMat4Mat4(model, projection);
+	for (int i = 0; i < pointCount; ++i) {
+		transformedVertices[i] = linalgMulMat4Vec4(finalTransform, vertices[i]);
+		transformedVertices[i].data[0] = transformedVertices[i].data[0] / transformedVertices[i].data[3];
+		transformedVertices[i].data[1] = transformedVertices[i].data[1] / transformedVertices[i].data[3];
+		transformedVertices[i].data[2] = transformedVertices[i].data[2] / transformedVertices[i].data[3];
+	}
+
+	for (int i = 0; i < pointCount; ++i) {
+		transformedVertices[i].data[0] = viewport.centerX + viewport.scaleX * transformedVertices[i].data[0];
+		transformedVertices[i].data[1] = viewport.centerY + viewport.scaleY * transformedVertices[i].data[1];
+	}
+
+	for (int i = 0; i < planeCount; ++i) {
+
+		vec4 vertex_a = transformedVertices[plane_vertices[i][0]];
+		vec4 vertex_b = transformedVertices[plane_vertices[i][1]];
+		vec4 vertex_c = transformedVertices[plane_vertices[i][2]];
+
+		vec3 tangent = {
+			vertex_b.data[0] - vertex_a.data[0],
+			vertex_b.data[1] - vertex_a.data[1],
+			vertex_b.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 bitangent = {
+			vertex_c.data[0] - vertex_a.data[0],
+			vertex_c.data[1] - vertex_a.data[1],
+			vertex_c.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 normal = linalgCross(tangent, bitangent);
+
+		if (normal.data[2] > 0) {
+			continue;
+		}
+
+		for (int j = 0; j < 4; ++j) {
+
+			int x_a = (int)transformedVertices[plane_vertices[i][j]].data[0];
+			int y_a = (int)transformedVertices[plane_vertices[i][j]].data[1];
+
+			int x_b = (int)transformedVertices[plane_vertices[i][(j + 1) % 4]].data[0];
+			int y_b = (int)transformedVertices[plane_vertices[i][(j + 1) % 4]].data[1];
+			graphicsEngine->draw_line_bresenham(
+				1.0f, 1.0f, 1.0f,
+				x_a, y_a,
+				x_b, y_b
+			);
+		}
+	}
+
+	logged = true;
+}
+
+void App::clipping_test() {
+	const int pointCount = 8;
+	vec4 vertices[pointCount] = {
+		{ 0.75f,  0.75f,  0.75f, 1.0f}, //0
+		{-0.75f,  0.75f,  0.75f, 1.0f}, //1
+		{-0.75f, -0.75f,  0.75f, 1.0f}, //2
+		{ 0.75f, -0.75f,  0.75f, 1.0f}, //3
+
+		{-0.75f,  0.75f, -0.75f, 1.0f}, //4
+		{ 0.75f,  0.75f, -0.75f, 1.0f}, //5
+		{ 0.75f, -0.75f, -0.75f, 1.0f}, //6
+		{-0.75f, -0.75f, -0.75f, 1.0f}, //7
+	};
+	vec4 transformedVertices[pointCount];
+
+	const int planeCount = 6;
+	int plane_vertices[planeCount][4] = {
+		{0, 1, 2, 3}, //front
+		{1, 0, 5, 4}, //top
+		{3, 6, 5, 0}, //right
+		{7, 6, 3, 2}, //bottom
+		{1, 4, 7, 2}, //left
+		{4, 5, 6, 7}  //back
+	};
+
+	theta += 0.1f * frameTime / 16.6f;
+	if (theta > 360) {
+		theta -= 360;
+	}
+	mat4 model = linalgMakeZRotation(theta);
+	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 2.0f, -5.0f)));
+
+	float fovy = 45.0f;
+	float aspect = viewport.centerX / viewport.centerY;
+	float near = 0.1f;
+	float far = 10.0f;
+	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
+	frustrum viewFrustrum = linalgMakeViewFrustrum(fovy, aspect, -near, -far);
+
+	for (int i = 0; i < pointCount; ++i) {
+		transformedVertices[i] = linalgMulMat4Vec4(model, vertices[i]);
+	}
+
+	for (int i = 0; i < planeCount; ++i) {
+
+		vec4 vertex_a = transformedVertices[plane_vertices[i][0]];
+		vec4 vertex_b = transformedVertices[plane_vertices[i][1]];
+		vec4 vertex_c = transformedVertices[plane_vertices[i][2]];
+
+		vec3 tangent = {
+			vertex_b.data[0] - vertex_a.data[0],
+			vertex_b.data[1] - vertex_a.data[1],
+			vertex_b.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 bitangent = {
+			vertex_c.data[0] - vertex_a.data[0],
+			vertex_c.data[1] - vertex_a.data[1],
+			vertex_c.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 normal = linalgCross(tangent, bitangent);
+		vec3 fragmentToViewer = linalgMakeVec3(
+			-vertex_a.data[0],
+			-vertex_a.data[1],
+			-vertex_a.data[2]
+		);
+
+		if (linalgDotVec3(normal, fragmentToViewer) < 0) {
+			continue;
+		}
+
+		fixedEdgeTable polygon;
+		polygon.vertexCount = 4;
+		for (int j = 0; j < 4; ++j) {
+			polygon.vertices[j] = transformedVertices[plane_vertices[i][j]];
+		}
+		
+		linalgFrustrumClipFixed(&polygon, viewFrustrum, false);
+		edgeTable edges = linalgViewFixedEdgeTable(&polygon);
+
+		for (int j = 0; j < edges.vertexCount; ++j) {
+
+			vec4 point_a = linalgMulMat4Vec4(projection, edges.vertices[j]);
+			point_a.data[0] = point_a.data[0] / point_a.data[3];
+			point_a.data[1] = point_a.data[1] / point_a.data[3];
+
+			vec4 point_b = linalgMulMat4Vec4(projection, edges.vertices[(j + 1) % edges.vertexCount]);
+			point_b.data[0] = point_b.data[0] / point_b.data[3];
+			point_b.data[1] = point_b.data[1] / point_b.data[3];
+
+			int x_a = (int)(viewport.centerX + viewport.scaleX * point_a.data[0]);
+			int y_a = (int)(viewport.centerY + viewport.scaleY * point_a.data[1]);
+			int x_b = (int)(viewport.centerX + viewport.scaleX * point_b.data[0]);
+			int y_b = (int)(viewport.centerY + viewport.scaleY * point_b.data[1]);
+
+			graphicsEngine->draw_line_bresenham(
+				1.0f, 1.0f, 1.0f,
+				x_a, y_a,
+				x_b, y_b
+			);
+		}
+	}
+
+	logged = true;
+}
+
+void App::flat_shading_test() {
+	theta += 0.1f * frameTime / 16.6f;
+	if (theta > 360) {
+		theta -= 360;
+	}
+	mat4 model = linalgMakeZRotation(theta);
+	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
+
+	float fovy = 45.0f;
+	float aspect = viewport.centerX / viewport.centerY;
+	float near = 0.1f;
+	float far = 10.0f;
+	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
+
+	transformCache.transform(cube, &model, &projection);
+
+	for (int i = 0; i < cube.polygon_count(); ++i) {
+
+		const int* corners = cube.polygon(i);
+
+		vec4 vertex_a = transformCache.view_position(corners[0]);
+		vec4 vertex_b = transformCache.view_position(corners[1]);
+		vec4 vertex_c = transformCache.view_position(corners[2]);
+
+		vec3 tangent = {
+			vertex_b.data[0] - vertex_a.data[0],
+			vertex_b.data[1] - vertex_a.data[1],
+			vertex_b.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 bitangent = {
+			vertex_c.data[0] - vertex_a.data[0],
+			vertex_c.data[1] - vertex_a.data[1],
+			vertex_c.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 normal = linalgNormalizeVec3(linalgCross(tangent, bitangent));
+		vec3 fragmentToViewer = linalgMakeVec3(
+			-vertex_a.data[0],
+			-vertex_a.data[1],
+			-vertex_a.data[2]
+		);
+
+		if (linalgDotVec3(normal, fragmentToViewer) < 0) {
+			continue;
+		}
+
+		fixedEdgeTable polygon;
+		polygon.vertexCount = 4;
+		for (int j = 0; j < 4; ++j) {
+			polygon.vertices[j] = transformCache.clip_position(corners[j]);
+		}
+
+		{
+			PROFILE_SCOPE(clip);
+			linalgClipSpaceClipFixed(&polygon, guardBand, false);
+			linalgProjectFixedEdgeTable(&polygon, viewport);
+		}
+		edgeTable edges = linalgViewFixedEdgeTable(&polygon);
+
+		vec3 torch = { 0.0f, 0.0f, 1.0f, 0.0f };
+		torch = linalgNormalizeVec3(torch);
+		vec3 diffuseColor = { 1.0f, 1.0f, 1.0f, 0.0f };
+		diffuseColor = linalgMulVec3(diffuseColor, std::max(0.0f, linalgDotVec3(normal, torch)));
+
+		graphicsEngine->draw_polygon_flat(
+			diffuseColor.data[0], diffuseColor.data[1], diffuseColor.data[2],
+			edges
+		);
+	}
+
+	logged = true;
+}
+
+/**
+* Draw a mesh lit head on by a torch at the viewer, culling back faces and
+* faces hidden behind what's already drawn, then flush the bins. Only flushed
+* polygons occlude, so each mesh drawn after this one is tested against it.
+*/
+void App::draw_lit_mesh(geometry::Mesh& mesh, const mat4& model, const mat4& projection, bool textured) {
+
+	transformCache.transform(mesh, &model, &projection);
+
+	for (int i = 0; i < mesh.polygon_count(); ++i) {
+
+		const int* corners = mesh.polygon(i);
+
+		vec4 vertex_a = transformCache.view_position(corners[0]);
+		vec4 vertex_b = transformCache.view_position(corners[1]);
+		vec4 vertex_c = transformCache.view_position(corners[2]);
+
+		vec3 tangent = {
+			vertex_b.data[0] - vertex_a.data[0],
+			vertex_b.data[1] - vertex_a.data[1],
+			vertex_b.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 bitangent = {
+			vertex_c.data[0] - vertex_a.data[0],
+			vertex_c.data[1] - vertex_a.data[1],
+			vertex_c.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 normal = linalgNormalizeVec3(linalgCross(tangent, bitangent));
+		vec3 fragmentToViewer = linalgMakeVec3(
+			-vertex_a.data[0],
+			-vertex_a.data[1],
+			-vertex_a.data[2]
+		);
+
+		if (linalgDotVec3(normal, fragmentToViewer) < 0) {
+			continue;
+		}
+
+		//skip polygons hidden behind what's already drawn, before paying for clipping
+		vec4 clipCorners[4];
+		for (int j = 0; j < 4; ++j) {
+			clipCorners[j] = transformCache.clip_position(corners[j]);
+		}
+		if (graphicsEngine->is_occluded(clipCorners, 4)) {
+			++culledPolygons;
+			continue;
+		}
+
+		fixedEdgeTable polygon;
+		polygon.vertexCount = 4;
+		for (int j = 0; j < 4; ++j) {
+			polygon.vertices[j] = transformCache.clip_position(corners[j]);
+
+			payload attribute = mesh.attributes[corners[j]];
+			vec3 torch = { 0.0f, 0.0f, 1.0f, 0.0f };
+			torch = linalgNormalizeVec3(torch);
+			vec3 diffuseColor = { attribute.data[0], attribute.data[1], attribute.data[2], 0.0f};
+			diffuseColor = linalgMulVec3(diffuseColor, std::max(0.0f, linalgDotVec3(normal, torch)));
+			attribute.data[0] = diffuseColor.data[0];
+			attribute.data[1] = diffuseColor.data[1];
+			attribute.data[2] = diffuseColor.data[2];
+
+			polygon.payloads[j] = attribute;
+		}
+
+		{
+			PROFILE_SCOPE(clip);
+			linalgClipSpaceClipFixed(&polygon, guardBand, true);
+			linalgProjectFixedEdgeTable(&polygon, viewport);
+		}
+		edgeTable edges = linalgViewFixedEdgeTable(&polygon);
+
+		if (textured) {
+			graphicsEngine->draw_polygon_textured(edges, tex);
+		}
+		else {
+			graphicsEngine->draw_polygon_blended(edges);
+		}
+	}
+
+	graphicsEngine->flush_bins();
+}
+
+void App::color_blending_test() {
+	theta += 0.1f * frameTime / 16.6f;
+	if (theta > 360) {
+		theta -= 360;
+	}
+	mat4 model = linalgMakeZRotation(theta);
+	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
+
+	float fovy = 45.0f;
+	float aspect = viewport.centerX / viewport.centerY;
+	float near = 0.1f;
+	float far = 10.0f;
+	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
+
+	draw_lit_mesh(cube, model, projection, false);
+
+	logged = true;
+}
+
+void App::texture_test() {
+
+	/*
+	int width, height, channels;
+	stbi_uc* textureData = stbi_load("tex/test.png", &width, &height, &channels, STBI_rgb_alpha);
+	if (!logged) {
+		std::cout << "Image loaded, width: " << width << ", height: " << height << ", channels: " << channels << std::endl;
+
+		std::cout << "----    texture data (raw):    ----" << std::endl;
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				std::cout
+					<< "(" << (float)textureData[4 * (width * y + x)]
+					<< ", " << (float)textureData[4 * (width * y + x) + 1]
+					<< ", " << (float)textureData[4 * (width * y + x) + 2]
+					<< ", " << (float)textureData[4 * (width * y + x) + 3] << ") ";
+			}
+			std::cout << std::endl;
+		}
+	}
+	logged = true;
+	free(textureData);
+	*/
+
+	theta += 0.1f * frameTime / 16.6f;
+	if (theta > 360) {
+		theta -= 360;
+	}
+	mat4 model = linalgMakeZRotation(theta);
+	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
+
+	float fovy = 45.0f;
+	float aspect = viewport.centerX / viewport.centerY;
+	float near = 0.1f;
+	float far = 10.0f;
+	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
+
+	draw_lit_mesh(texturedCube, model, projection, true);
+
+	logged = true;
+}
+
+/**
+* Draw the textured cube with the colored cube hidden right behind it. The front
+* cube is flushed before the back one is drawn, so the back one's faces should
+* all be culled before they're clipped.
+*/
+void App::occlusion_test() {
+
+	theta += 0.1f * frameTime / 16.6f;
+	if (theta > 360) {
+		theta -= 360;
+	}
+	mat4 rotation = linalgMakeZRotation(theta);
+	rotation = linalgMulMat4Mat4(rotation, linalgMakeXRotation(2 * theta));
+	rotation = linalgMulMat4Mat4(rotation, linalgMakeYRotation(3 * theta));
+
+	float fovy = 45.0f;
+	float aspect = viewport.centerX / viewport.centerY;
+	float near = 0.1f;
+	float far = 20.0f;
+	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
+
+	//far enough back that its whole silhouette fits inside the front cube's
+	mat4 model = linalgMulMat4Mat4(rotation, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -5.0f)));
+	draw_lit_mesh(texturedCube, model, projection, true);
+	model = linalgMulMat4Mat4(rotation, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -14.0f)));
+	draw_lit_mesh(cube, model, projection, false);
+
+	logged = true;
+}
+
+/**
+* Draw the model given to load_model, textured and spinning like texture_test's cube.
+*/
+void App::model_test() {
+
+	theta += 0.1f * frameTime / 16.6f;
+	if (theta > 360) {
+		theta -= 360;
+	}
+	mat4 model = linalgMakeTranslation(linalgMulVec3(importedCenter, -1.0f));
+	model = linalgMulMat4Mat4(model, linalgMakeZRotation(theta));
+	model = linalgMulMat4Mat4(model, linalgMakeXRotation(2 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeYRotation(3 * theta));
+	model = linalgMulMat4Mat4(model, linalgMakeTranslation(linalgMakeVec3(0.0f, 0.0f, -importedDistance)));
+
+	float fovy = 45.0f;
+	float aspect = viewport.centerX / viewport.centerY;
+	float near = 0.02f * importedDistance;
+	float far = 2.0f * importedDistance;
+	mat4 projection = linalgMakePerspectiveProjection(fovy, aspect, near, far);
+
+	transformCache.transform(&importedMesh.positions, &model, &projection);
+
+	int cornerCount = importedMesh.cornersPerPolygon;
+	for (int i = 0; i < importedMesh.polygonCount; ++i) {
+
+		const int* corners = importedMesh.polygon(i);
+
+		vec4 vertex_a = transformCache.view_position(corners[0]);
+		vec4 vertex_b = transformCache.view_position(corners[1]);
+		vec4 vertex_c = transformCache.view_position(corners[2]);
+
+		vec3 tangent = {
+			vertex_b.data[0] - vertex_a.data[0],
+			vertex_b.data[1] - vertex_a.data[1],
+			vertex_b.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 bitangent = {
+			vertex_c.data[0] - vertex_a.data[0],
+			vertex_c.data[1] - vertex_a.data[1],
+			vertex_c.data[2] - vertex_a.data[2],
+			0.0f
+		};
+
+		vec3 normal = linalgNormalizeVec3(linalgCross(tangent, bitangent));
+		vec3 fragmentToViewer = linalgMakeVec3(
+			-vertex_a.data[0],
+			-vertex_a.data[1],
+			-vertex_a.data[2]
+		);
+
+		if (linalgDotVec3(normal, fragmentToViewer) < 0) {
+			continue;
+		}
+
+		fixedEdgeTable polygon;
+		polygon.vertexCount = cornerCount;
+		for (int j = 0; j < cornerCount; ++j) {
+			polygon.vertices[j] = transformCache.clip_position(corners[j]);
+
+			payload attribute = importedMesh.attributes[corners[j]];
+			vec3 torch = { 0.0f, 0.0f, 1.0f, 0.0f };
+			vec3 diffuseColor = { attribute.data[0], attribute.data[1], attribute.data[2], 0.0f };
+			diffuseColor = linalgMulVec3(diffuseColor, std::max(0.0f, linalgDotVec3(normal, torch)));
+			attribute.data[0] = diffuseColor.data[0];
+			attribute.data[1] = diffuseColor.data[1];
+			attribute.data[2] = diffuseColor.data[2];
+
+			polygon.payloads[j] = attribute;
+		}
+
+		{
+			PROFILE_SCOPE(clip);
+			linalgClipSpaceClipFixed(&polygon, guardBand, true);
+			linalgProjectFixedEdgeTable(&polygon, viewport);
+		}
+		edgeTable edges = linalgViewFixedEdgeTable(&polygon);
+
+		graphicsEngine->draw_polygon_textured(edges, tex);
+	}
+}
+
+/**
+* Calculates the App's framerate and updates the window title
+*/
+void App::calculateFrameRate() {
+	currentTime = glfwGetTime();
+	double delta = currentTime - lastTime;
+
+	if (delta >= 1) {
+		int framerate{ std::max(1, int(numFrames / delta)) };
+		std::stringstream title;
+		frameLatencyStats latency = graphicsEngine->get_frame_latency_stats();
+		title << "Running at " << framerate << " fps, latency " << latency.median
+			<< " ms (p99 " << latency.p99 << " ms).";
+		glfwSetWindowTitle(window, title.str().c_str());
+#ifdef ENABLE_PROFILING
+		vkProfiling::Profiler::get_profiler()->print_stage_stats();
+#endif
+		lastTime = currentTime;
+		numFrames = -1;
+		frameTime = float(1000.0 / framerate);
+	}
+
+	++numFrames;
+}
+
+/**
+* App destructor.
+*/
+App::~App() {
+	graphicsEngine->free_texture(tex);
+	delete graphicsEngine;
+#ifdef ENABLE_PROFILING
+	vkProfiling::Profiler::get_profiler()->write_chrome_trace("profile.json");
+#endif
 }
\ No newline at end of file
@@ -1,37 +1,66 @@
-#pragma once
-#include "../config.h"
-#include "../view/engine.h"
-
-class App {
-
-private:
-	Engine* graphicsEngine;
-	GLFWwindow* window;
-
-	double lastTime, currentTime;
-	int numFrames;
-	float frameTime;
-
-	void build_glfw_window(int width, int height);
-
-	void calculateFrameRate();
-
-	double renderTimeA = 0.0, renderTimeB = 0.0;
-	int trialCount = 0;
-	bool logged = false;
-	float theta = 0.0f;
-	texture tex;
-
-public:
-	App(int width, int height, bool debug);
-	~App();
-	void run();
-
-	void lines_test();
-	void projection_test();
-	void backface_test();
-	void clipping_test();
-	void flat_shading_test();
-	void color_blending_test();
-	void texture_test();
+#pragma once
+#include "../config.h"
+#include "../view/engine.h"
+#include "../view/geometry/mesh.h"
+#include "../view/geometry/mesh_file.h"
+
+class App {
+
+private:
+	Engine* graphicsEngine;
+	GLFWwindow* window;
+
+	double lastTime, currentTime;
+	int numFrames;
+	float frameTime = 0.0f;
+
+	void build_glfw_window(int width, int height);
+
+	void calculateFrameRate();
+
+	void build_meshes();
+
+	void build_scenes();
+
+	bool logged = false;
+	float theta = 0.0f;
+	//how far past the screen edges polygons may reach before they're clipped (1 is the edge)
+	float guardBand = 2.0f;
+	viewportTransform viewport;
+	geometry::Mesh cube, texturedCube;
+	//a model loaded from a file, and where to put it to fill the view like the cubes
+	geometry::MappedMesh importedMesh;
+	vec3 importedCenter;
+	float importedDistance = 5.0f;
+	geometry::TransformCache transformCache;
+	texture tex;
+	//polygons draw_lit_mesh skipped as occluded in the current frame
+	uint64_t culledPolygons = 0;
+
+	void draw_lit_mesh(geometry::Mesh& mesh, const mat4& model, const mat4& projection, bool textured);
+
+public:
+	App(int width, int height, bool debug);
+	App(int width, int height, renderTarget::RenderTarget* target);
+	~App();
+	void run();
+
+	void draw_frame(void (App::*test)());
+	void set_theta(float theta);
+	void use_reference_paths();
+	void use_dirty_tracking();
+	void count_overdraw();
+	uint64_t get_overdraw_count();
+	uint64_t get_culled_polygon_count();
+	bool load_model(const char* filename);
+
+	void lines_test();
+	void projection_test();
+	void backface_test();
+	void clipping_test();
+	void flat_shading_test();
+	void color_blending_test();
+	void texture_test();
+	void occlusion_test();
+	void model_test();
 };
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+	//each thread's ring, owned by the profiler so it outlives the thread
+	thread_local vkProfiling::EventRing* threadRing{ nullptr };
+}
+
+const char* vkProfiling::stage_name(profileStage stage) {
+
+	switch (stage) {
+	case profileStage::clear:
+		return "clear";
+	case profileStage::transform:
+		return "transform";
+	case profileStage::clip:
+		return "clip";
+	case profileStage::rasterize:
+		return "rasterize";
+	case profileStage::shade:
+		return "shade";
+	case profileStage::flush:
+		return "flush";
+	case profileStage::fenceWait:
+		return "fence wait";
+	case profileStage::acquire:
+		return "acquire";
+	case profileStage::present:
+		return "present";
+	default:
+		return "unknown";
+	}
+}
+
+void vkProfiling::EventRing::push(profileStage stage, int64_t start, int64_t end) {
+
+	uint64_t index = written.load(std::memory_order_relaxed);
+	slot& event = slots[index % capacity];
+	//keeps the overwrite from showing before the last push's count does: a reader
+	//which sees any of it also sees that count, and drops the slot as torn
+	std::atomic_thread_fence(std::memory_order_release);
+	event.stage.store(static_cast<int>(stage), std::memory_order_relaxed);
+	event.start.store(start, std::memory_order_relaxed);
+	event.end.store(end, std::memory_order_relaxed);
+	written.store(index + 1, std::memory_order_release);
+}
+
+void vkProfiling::EventRing::read(std::vector<profileEvent>& events, int thread) const {
+
+	uint64_t last = written.load(std::memory_order_acquire);
+	uint64_t first = last > capacity ? last - capacity : 0;
+
+	size_t copied = events.size();
+	for (uint64_t i = first; i < last; ++i) {
+		const slot& event = slots[i % capacity];
+		events.push_back({
+			static_cast<profileStage>(event.stage.load(std::memory_order_relaxed)), thread,
+			event.start.load(std::memory_order_relaxed), event.end.load(std::memory_order_relaxed)
+		});
+	}
+
+	//the writer may have lapped the oldest slots while they were copied,
+	//anything it could have started overwriting is dropped
+	std::atomic_thread_fence(std::memory_order_acquire);
+	uint64_t now = written.load(std::memory_order_relaxed);
+	uint64_t firstIntact = now + 1 > capacity ? now + 1 - capacity : 0;
+	if (firstIntact > first) {
+		size_t torn = static_cast<size_t>(std::min(firstIntact, last) - first);
+		events.erase(events.begin() + copied, events.begin() + copied + torn);
+	}
+}
+
+vkProfiling::Profiler* vkProfiling::Profiler::get_profiler() {
+
+	static Profiler profiler;
+	return &profiler;
+}
+
+void vkProfiling::Profiler::record(profileStage stage, int64_t start, int64_t end) {
+
+	if (!threadRing) {
+		std::lock_guard<std::mutex> guard(ringLock);
+		rings.push_back(std::make_unique<EventRing>());
+		threadRing = rings.back().get();
+	}
+
+	threadRing->push(stage, start, end);
+}
+
+std::vector<vkProfiling::profileEvent> vkProfiling::Profiler::collect() {
+
+	std::vector<profileEvent> events;
+
+	std::lock_guard<std::mutex> guard(ringLock);
+	for (size_t i = 0; i < rings.size(); ++i) {
+		rings[i]->read(events, static_cast<int>(i));
+	}
+
+	return events;
+}
+
+bool vkProfiling::Profiler::write_chrome_trace(const std::string& filename) {
+
+	std::ofstream file(filename);
+	if (!file) {
+		return false;
+	}
+
+	//complete ("X") events, timestamps and durations in microseconds
+	file << "{\"traceEvents\":[" << std::fixed << std::setprecision(3);
+	bool first = true;
+	for (const profileEvent& event : collect()) {
+		file << (first ? "\n" : ",\n");
+		file << "{\"name\":\"" << stage_name(event.stage) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+			<< ",\"ts\":" << 0.001 * event.start << ",\"dur\":" << 0.001 * (event.end - event.start) << "}";
+		first = false;
+	}
+	file << "\n]}\n";
+
+	return static_cast<bool>(file);
+}
+
+void vkProfiling::Profiler::print_stage_stats() {
+
+	std::vector<int64_t> durations[static_cast<int>(profileStage::stageCount)];
+	for (const profileEvent& event : collect()) {
+		durations[static_cast<int>(event.stage)].push_back(event.end - event.start);
+	}
+
+	for (int i = 0; i < static_cast<int>(profileStage::stageCount); ++i) {
+
+		std::vector<int64_t>& stage = durations[i];
+		if (stage.empty()) {
+			continue;
+		}
+
+		std::sort(stage.begin(), stage.end());
+		int64_t median = stage[stage.size() / 2];
+		int64_t p99 = stage[(stage.size() - 1) * 99 / 100];
+
+		std::cout << std::setw(12) << stage_name(static_cast<profileStage>(i)) << ": p50 " << 0.001 * median
+			<< " us, p99 " << 0.001 * p99 << " us (" << stage.size() << " samples)" << std::endl;
+	}
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include "../config.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+/*
+	Timers are only built in when ENABLE_PROFILING is defined, otherwise
+	PROFILE_SCOPE expands to nothing and costs nothing.
+*/
+#ifdef ENABLE_PROFILING
+#define PROFILE_SCOPE(stage) vkProfiling::ScopedTimer scopedTimer(vkProfiling::profileStage::stage)
+#else
+#define PROFILE_SCOPE(stage)
+#endif
+
+namespace vkProfiling {
+
+	/**
+		The parts of a frame which get timed
+	*/
+	enum class profileStage {
+		clear,
+		transform,
+		clip,
+		rasterize,
+		shade,
+		flush,
+		fenceWait,
+		acquire,
+		present,
+		stageCount
+	};
+
+	/**
+		\returns the name a stage is reported under
+	*/
+	const char* stage_name(profileStage stage);
+
+	/**
+		One timed scope, in nanoseconds since the profiler started
+	*/
+	struct profileEvent {
+		profileStage stage;
+		int thread;
+		int64_t start, end;
+	};
+
+	/**
+		A fixed size ring of events written by one thread only. Writing never
+		locks or allocates, the oldest events are simply overwritten. Any thread
+		may read it, events overwritten during the read are left out.
+	*/
+	class EventRing {
+
+	public:
+
+		static const uint64_t capacity = 1 << 14;
+
+		/**
+			Record an event, only ever called by the owning thread.
+		*/
+		void push(profileStage stage, int64_t start, int64_t end);
+
+		/**
+			Copy out the events still in the ring, oldest first.
+
+			\param events the list to append to
+			\param thread the id to tag the events with
+		*/
+		void read(std::vector<profileEvent>& events, int thread) const;
+
+	private:
+
+		struct slot {
+			std::atomic<int> stage;
+			std::atomic<int64_t> start, end;
+		};
+
+		slot slots[capacity];
+		std::atomic<uint64_t> written{ 0 };
+	};
+
+	class Profiler {
+
+	public:
+
+		/**
+			\returns the one profiler, which worker threads may be first to ask for
+		*/
+		static Profiler* get_profiler();
+
+		/**
+			\returns nanoseconds since the profiler started
+		*/
+		int64_t now() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - started).count();
+		}
+
+		/**
+			Record a timed scope into the calling thread's ring, making the
+			ring the first time the thread records anything.
+		*/
+		void record(profileStage stage, int64_t start, int64_t end);
+
+		/**
+			\returns every event still held, from every thread
+		*/
+		std::vector<profileEvent> collect();
+
+		/**
+			Write the held events as a Chrome trace_event file, which
+			chrome://tracing and Perfetto can open.
+
+			\param filename the file to write
+			\returns whether the file could be written
+		*/
+		bool write_chrome_trace(const std::string& filename);
+
+		/**
+			Print the median and 99th percentile duration of each stage
+			over the events currently held.
+		*/
+		void print_stage_stats();
+
+	private:
+
+		std::chrono::steady_clock::time_point started{ std::chrono::steady_clock::now() };
+
+		//only taken when a thread records its first event, or to read
+		std::mutex ringLock;
+		std::vector<std::unique_ptr<EventRing>> rings;
+	};
+
+	/**
+		Times the scope it's declared in, use it through PROFILE_SCOPE.
+	*/
+	class ScopedTimer {
+
+	public:
+
+		ScopedTimer(profileStage stage) : stage(stage), start(Profiler::get_profiler()->now()) {}
+
+		~ScopedTimer() {
+			Profiler* profiler = Profiler::get_profiler();
+			profiler->record(stage, start, profiler->now());
+		}
+
+	private:
+
+		profileStage stage;
+		int64_t start;
+	};
+}
@@ -1,722 +1,1039 @@
-﻿#include "linear_algebros.h"
-#include <math.h>
-
-frustrum linalgMakeViewFrustrum(float fovy, float aspect, float near, float far) {
-	frustrum f;
-	float ytop = fabsf(near) * tanf(linalgDeg2Rad(fovy / 2));
-	float xright = ytop * aspect;
-
-	//near
-	vec3 p0 = linalgMakeVec3(0, 0, near);
-	vec3 n = linalgMakeVec3(0, 0, -1);
-	f.planes[0] = linalgMakePlane(p0, n);
-
-	//far
-	p0 = linalgMakeVec3(0, 0, far);
-	n = linalgMakeVec3(0, 0, 1);
-	f.planes[1] = linalgMakePlane(p0, n);
-
-	//top
-	p0 = linalgMakeVec3(0, ytop, near);
-	n = linalgMakeVec3(0, near / ytop, -1);
-	f.planes[2] = linalgMakePlane(p0, n);
-
-	//bottom
-	p0 = linalgMakeVec3(0, -ytop, near);
-	n = linalgMakeVec3(0, -near / ytop, -1);
-	f.planes[3] = linalgMakePlane(p0, n);
-
-	//left
-	p0 = linalgMakeVec3(-xright, 0, near);
-	n = linalgMakeVec3(-near / xright, 0, -1);
-	f.planes[4] = linalgMakePlane(p0, n);
-
-	//right
-	p0 = linalgMakeVec3(xright, 0, near);
-	n = linalgMakeVec3(near / xright, 0, -1);
-	f.planes[5] = linalgMakePlane(p0, n);
-
-	return f;
-}
-
-edgeTable linalgFrustrumClipSimple(edgeTable input, frustrum f) {
-
-	for (int i = 0; i < 6; ++i) {
-		input = linalgClipAgainstBoundary(input, f.planes[i]);
-	}
-
-	return input;
-}
-
-plane linalgMakePlane(vec3 p0, vec3 n) {
-
-	n = linalgNormalizeVec3(n);
-
-	plane p;
-	p.A = n.data[0];
-	p.B = n.data[1];
-	p.C = n.data[2];
-
-	p.D = -linalgDotVec3(p0, n);
-
-	return p;
-}
-
-bool linalgPointBehindPlane(vec4 v, plane p) {
-	return p.A * v.data[0] + p.B * v.data[1] + p.C * v.data[2] + p.D < 0;
-}
-
-float linalgEdgePlaneIntersectionPoint(vec4 a, vec4 b, plane p) {
-	return -(a.data[0] * p.A + a.data[1] * p.B + a.data[2] * p.C + p.D) /
-		(p.A * (b.data[0] - a.data[0]) + p.B * (b.data[1] - a.data[1]) + p.C * (b.data[2] - a.data[2]));
-}
-
-edgeTable linalgClipAgainstBoundary(edgeTable input, plane p) {
-
-	edgeTable output;
-	output.vertices = (vec4*)malloc(2 * input.vertexCount * sizeof(vec4));
-	output.vertexCount = 0;
-
-	for (int i = 0; i < input.vertexCount; ++i) {
-		vec4 a = input.vertices[i];
-		vec4 b = input.vertices[(i + 1) % input.vertexCount];
-		vec4 c;
-		float t = linalgEdgePlaneIntersectionPoint(a, b, p);
-		c.vector = _mm_fmadd_ps(
-			_mm_set1_ps(t),
-			_mm_sub_ps(b.vector, a.vector),
-			a.vector
-		);
-
-		if (!linalgPointBehindPlane(b, p)) { //if b inside of boundary
-			if (linalgPointBehindPlane(a, p)) { // if a outside of boundary
-				output.vertices[output.vertexCount++] = c;
-			}
-			output.vertices[output.vertexCount++] = b;
-		}
-		else if (!linalgPointBehindPlane(a, p)) { //if a is visible
-			output.vertices[output.vertexCount++] = c;
-		}
-	}
-
-	free(input.vertices);
-	return output;
-}
-
-edgeTable linalgFrustrumClip(edgeTable input, frustrum f) {
-
-	for (int i = 0; i < 6; ++i) {
-		input = linalgClipAgainstBoundaryWithAttributes(input, f.planes[i]);
-	}
-
-	return input;
-}
-
-edgeTable linalgClipAgainstBoundaryWithAttributes(edgeTable input, plane p) {
-
-	edgeTable output;
-	output.vertices = (vec4*)malloc(2 * input.vertexCount * sizeof(vec4));
-	output.payloads = (payload*)malloc(2 * input.vertexCount * sizeof(payload));
-	output.vertexCount = 0;
-
-	for (int i = 0; i < input.vertexCount; ++i) {
-		vec4 a = input.vertices[i];
-		vec4 b = input.vertices[(i + 1) % input.vertexCount];
-		vec4 c;
-		float t = linalgEdgePlaneIntersectionPoint(a, b, p);
-		c.vector = _mm_fmadd_ps(
-			_mm_set1_ps(t),
-			_mm_sub_ps(b.vector, a.vector),
-			a.vector
-		);
-
-		payload payload_a, payload_b, payload_c;
-		payload_a = input.payloads[i];
-		payload_b = input.payloads[(i + 1) % input.vertexCount];
-		payload_c.lump = _mm256_fmadd_ps(
-			_mm256_set1_ps(t),
-			_mm256_sub_ps(payload_b.lump, payload_a.lump),
-			payload_a.lump
-		);
-
-		if (!linalgPointBehindPlane(b, p)) { //if b inside of boundary
-			if (linalgPointBehindPlane(a, p)) { // if a outside of boundary
-				output.vertices[output.vertexCount] = c;
-				output.payloads[output.vertexCount++] = payload_c;
-			}
-			output.vertices[output.vertexCount] = b;
-			output.payloads[output.vertexCount++] = payload_b;
-		}
-		else if (!linalgPointBehindPlane(a, p)) { //if a is visible
-			output.vertices[output.vertexCount] = c;
-			output.payloads[output.vertexCount++] = payload_c;
-		}
-	}
-
-	free(input.vertices);
-	free(input.payloads);
-	return output;
-}
-
-/*-------- Conversions        ----------*/
-
-float linalgDeg2Rad(float angle) {
-	return angle * pi / 180.0f;
-}
-
-float linalgRad2Deg(float angle) {
-	return angle * 180.0f / pi;
-}
-
-/*-------- Vec3 Operations    ----------*/
-
-vec3 linalgMakeVec3(float x, float y, float z) {
-
-	vec3 result;
-
-	result.data[0] = x;
-	result.data[1] = y;
-	result.data[2] = z;
-	result.data[3] = 0;
-
-	return result;
-}
-
-float linalgDotVec3(vec3 a, vec3 b) {
-	return a.data[0] * b.data[0] + a.data[1] * b.data[1] + a.data[2] * b.data[2];
-}
-
-vec3 linalgCross(vec3 a, vec3 b) {
-	vec3 result;
-
-	result.data[0] = a.data[1] * b.data[2] - a.data[2] * b.data[1];
-	result.data[1] = a.data[2] * b.data[0] - a.data[0] * b.data[2];
-	result.data[2] = a.data[0] * b.data[1] - a.data[1] * b.data[0];
-	result.data[3] = 0;
-
-	return result;
-}
-
-vec3 linalgNormalizeVec3(vec3 a) {
-
-	float invMagnitude = 1.0f / sqrtf(a.data[0] * a.data[0] + a.data[1] * a.data[1] + a.data[2] * a.data[2]);
-
-	vec3 result;
-
-	result.vector = _mm_mul_ps(a.vector, _mm_set1_ps(invMagnitude));
-
-	return result;
-}
-
-vec3 linalgSubVec3(vec3 a, vec3 b) {
-	
-	vec3 result;
-
-	result.vector = _mm_sub_ps(a.vector, b.vector);
-
-	return result;
-}
-
-vec3 linalgAddVec3(vec3 a, vec3 b) {
-
-	vec3 result;
-
-	result.vector = _mm_add_ps(a.vector, b.vector);
-
-	return result;
-}
-
-vec3 linalgMulVec3(vec3 a, float scalar) {
-
-	vec3 result;
-
-	result.vector = _mm_mul_ps(a.vector, _mm_set1_ps(scalar));
-
-	return result;
-}
-
-float linalgAngleBetweenVectors3(vec3 a, vec3 b) {
-
-	float denominator = sqrtf(linalgDotVec3(a, a) * linalgDotVec3(b, b));
-
-	float dot = linalgDotVec3(a, b);
-
-	return linalgRad2Deg(acosf(dot / denominator));
-}
-
-vec3 linalgProject(vec3 incoming, vec3 basis) {
-
-	return linalgMulVec3(basis, linalgDotVec3(incoming, basis) / linalgDotVec3(basis, basis));
-}
-
-vec3 linalgReject(vec3 incoming, vec3 basis) {
-	
-	return linalgSubVec3(incoming, linalgProject(incoming, basis));
-}
-
-vec3 linalgReflect(vec3 incident, vec3 normal) {
-
-	vec3 result;
-	// reflected = incident − 2(incident.normal)normal
-	result.vector = _mm_fmadd_ps(
-		normal.vector, 
-		_mm_set1_ps(-2.0f * linalgDotVec3(incident, normal)),
-		incident.vector
-	);
-
-	return result;
-}
-
-vec3 linalgLerpVec3(vec3 a, vec3 b, float t) {
-
-	vec3 result;
-
-	result.vector = _mm_fmadd_ps(
-		_mm_sub_ps(b.vector, a.vector),
-		_mm_set1_ps(t),
-		a.vector
-	);
-
-	return result;
-}
-
-vec3 linalgSlerpVec3(vec3 a, vec3 b, float t) {
-
-	if (t < 0.1f) {
-		return linalgLerpVec3(a, b, t);
-	}
-
-	float angle = linalgAngleBetweenVectors3(a, b);
-
-	float denominator = sinf(linalgDeg2Rad(angle));
-
-	vec3 result;
-
-	result.vector = _mm_fmadd_ps(
-		a.vector,
-		_mm_set1_ps(sinf(1 - t) * angle / denominator),
-		_mm_mul_ps(b.vector, _mm_set1_ps(sinf(t * angle) / denominator))
-	);
-
-	return result;
-}
-
-vec3 linalgNlerpVec3(vec3 a, vec3 b, float t) {
-
-	return linalgNormalizeVec3(linalgLerpVec3(a, b, t));
-}
-
-bool linalgCloseVec3(vec3 a, vec3 b) {
-	
-	vec3 displacement = linalgSubVec3(a, b);
-
-	return linalgDotVec3(displacement, displacement) < eps;
-}
-
-/*-------- Vector4 Operations ----------*/
-
-float linalgDotVec4(vec4 a, vec4 b) {
-	return a.data[0] * b.data[0] + a.data[1] * b.data[1] + a.data[2] * b.data[2] + a.data[3] * b.data[3];
-}
-
-vec4 linalgNormalizeVec4(vec4 a) {
-
-	float invMagnitude = 1.0f / sqrtf(
-		a.data[0] * a.data[0] + a.data[1] * a.data[1] + a.data[2] * a.data[2] + a.data[3] * a.data[3]
-	);
-
-	vec4 result;
-
-	result.vector = _mm_mul_ps(a.vector, _mm_set1_ps(invMagnitude));
-
-	return result;
-}
-
-/*-------- Matrix4 Operations ----------*/
-
-mat4 linalgMakeIdentity4() {
-	mat4 result;
-
-	result.column[0] = _mm_setr_ps(1, 0, 0, 0);
-	result.column[1] = _mm_setr_ps(0, 1, 0, 0);
-	result.column[2] = _mm_setr_ps(0, 0, 1, 0);
-	result.column[3] = _mm_setr_ps(0, 0, 0, 1);
-
-	return result;
-}
-
-mat4 linalgMakePerspectiveProjection(
-	float fovy, float aspect, float near, float far) {
-
-	float yMax = near * tanf(linalgDeg2Rad(fovy / 2));
-	float xMax = yMax * aspect;
-
-	/*
-	
-		The matrix is:
-
-		[E 0  A 0]
-		[0 F  B 0]
-		[0 0  C D]
-		[0 0 -1 0]
-
-		Given by:
-
-		float left{ -xMax };
-		float right{ -xMax };
-		float top{ -yMax };
-		float bottom{ yMax };
-
-		float A{ (right + left) / (right - left) };
-		float B{ (top + bottom) / (top - bottom) };
-		float C{ -(far + near) / (far - near) };
-		float D{ -2.0f * far * near / (far - near) };
-		float E{ 2.0f * near / (right - left) };
-		float F{ 2.0f * near / (top - bottom) };
-
-		(In practice this simplifies out quite a bit though.)
-	*/
-	float C = -(far + near) / (far - near);
-	float D = -2.0f * far * near / (far - near);
-	float E = near / xMax;
-	float F = near / yMax;
-
-	mat4 result;
-
-	result.column[0] = _mm_setr_ps(E, 0, 0,  0);
-	result.column[1] = _mm_setr_ps(0, F, 0,  0);
-	result.column[2] = _mm_setr_ps(0, 0, C, -1);
-	result.column[3] = _mm_setr_ps(0, 0, D,  0);
-
-	return result;
-}
-
-mat4 linalgMakeLookAt(vec3 eye, vec3 target, vec3 up) {
-
-	vec3 forwards = linalgNormalizeVec3(linalgSubVec3(target, eye));
-	vec3 right = linalgNormalizeVec3(linalgCross(forwards, up));
-	up = linalgNormalizeVec3(linalgCross(right, forwards));
-
-	forwards = linalgMulVec3(forwards, -1);
-
-	mat4 result;
-
-	result.column[0] = _mm_setr_ps(right.data[0], up.data[0], forwards.data[0], 0);
-	result.column[1] = _mm_setr_ps(right.data[1], up.data[1], forwards.data[1], 0);
-	result.column[2] = _mm_setr_ps(right.data[2], up.data[2], forwards.data[2], 0);
-	result.column[3] = _mm_setr_ps(-linalgDotVec3(right, eye), -linalgDotVec3(up, eye), -linalgDotVec3(forwards, eye), 1);
-
-	return result;
-}
-
-mat4 linalgMakeTranslation(vec3 translation) {
-
-	mat4 result;
-
-	result.column[0] = _mm_setr_ps(1, 0, 0, 0);
-	result.column[1] = _mm_setr_ps(0, 1, 0, 0);
-	result.column[2] = _mm_setr_ps(0, 0, 1, 0);
-	result.column[3] = _mm_setr_ps(translation.data[0], translation.data[1], translation.data[2], 1);
-
-	return result;
-}
-
-mat4 linalgMakeXRotation(float angle) {
-
-	angle = linalgDeg2Rad(angle);
-	float cT = cosf(angle);
-	float sT = sinf(angle);
-
-	mat4 result;
-
-	result.column[0] = _mm_setr_ps(1,  0,   0, 0);
-	result.column[1] = _mm_setr_ps(0, cT, -sT, 0);
-	result.column[2] = _mm_setr_ps(0, sT,  cT, 0);
-	result.column[3] = _mm_setr_ps(0,  0,   0, 1);
-
-	return result;
-}
-
-mat4 linalgMakeYRotation(float angle) {
-
-	angle = linalgDeg2Rad(angle);
-	float cT = cosf(angle);
-	float sT = sinf(angle);
-
-	mat4 result;
-
-	result.column[0] = _mm_setr_ps( cT, 0, sT, 0);
-	result.column[1] = _mm_setr_ps(  0, 1,  0, 0);
-	result.column[2] = _mm_setr_ps(-sT, 0, cT, 0);
-	result.column[3] = _mm_setr_ps(  0, 0,  0, 1);
-
-	return result;
-}
-
-mat4 linalgMakeZRotation(float angle) {
-
-	angle = linalgDeg2Rad(angle);
-	float cT = cosf(angle);
-	float sT = sinf(angle);
-
-	mat4 result;
-
-	result.column[0] = _mm_setr_ps(cT, -sT, 0, 0);
-	result.column[1] = _mm_setr_ps(sT,  cT, 0, 0);
-	result.column[2] = _mm_setr_ps( 0,   0, 1, 0);
-	result.column[3] = _mm_setr_ps( 0,   0, 0, 1);
-
-	return result;
-}
-
-vec4 linalgMulMat4Vec4(mat4 m, vec4 v) {
-
-	vec4 result;
-
-	result.vector = _mm_fmadd_ps(_mm_set1_ps(v.data[0]), m.column[0],
-					_mm_fmadd_ps(_mm_set1_ps(v.data[1]), m.column[1],
-					_mm_fmadd_ps(_mm_set1_ps(v.data[2]), m.column[2],
-					_mm_mul_ps(_mm_set1_ps(v.data[3]), m.column[3])
-					)
-				)
-	);
-
-	return result;
-}
-
-mat4 linalgMulMat4Mat4(mat4 m1, mat4 m2) {
-
-	mat4 result;
-
-	result.column_vector[0] = linalgMulMat4Vec4(m2, m1.column_vector[0]);
-	result.column_vector[1] = linalgMulMat4Vec4(m2, m1.column_vector[1]);
-	result.column_vector[2] = linalgMulMat4Vec4(m2, m1.column_vector[2]);
-	result.column_vector[3] = linalgMulMat4Vec4(m2, m1.column_vector[3]);
-
-	return result;
-}
-
-mat4 linalgAddMat4(mat4 m1, mat4 m2) {
-
-	mat4 m3;
-	m3.chunk[0] = _mm256_add_ps(m1.chunk[0], m2.chunk[0]);
-	m3.chunk[1] = _mm256_add_ps(m1.chunk[1], m2.chunk[1]);
-
-	return m3;
-}
-
-mat4 linalgMulMat4Scalar(mat4 matrix, float scalar) {
-
-	mat4 m3;
-	__m256 scale = _mm256_set1_ps(scalar);
-	m3.chunk[0] = _mm256_mul_ps(matrix.chunk[0], scale);
-	m3.chunk[1] = _mm256_mul_ps(matrix.chunk[1], scale);
-
-	return m3;
-}
-
-mat4 linalgLerpMat4(mat4 m1, mat4 m2, float t) {
-
-	mat4 m3;
-	__m256 scale = _mm256_set1_ps(t);
-
-	m3.chunk[0] = _mm256_fmadd_ps(
-		_mm256_sub_ps(m2.chunk[0], m1.chunk[0]),
-		scale,
-		m1.chunk[0]
-	);
-
-	m3.chunk[1] = _mm256_fmadd_ps(
-		_mm256_sub_ps(m2.chunk[1], m1.chunk[1]),
-		scale,
-		m1.chunk[1]
-	);
-
-	return m3;
-}
-
-mat4 linalgTranspose(mat4 matrix) {
-
-	mat4 transposed;
-
-	for (int i = 0; i < 4; ++i) {
-		for (int j = 0; j < 4; ++j) {
-			transposed.data[i + 4 * j] = matrix.data[j + 4 * i];
-		}
-	}
-
-	return transposed;
-}
-
-mat4 linalgTransformInverse(mat4 matrix) {
-
-	//Get the scale factors
-	float a = sqrtf(linalgDotVec4(matrix.column_vector[0], matrix.column_vector[0]));
-	float b = sqrtf(linalgDotVec4(matrix.column_vector[1], matrix.column_vector[1]));
-	float c = sqrtf(linalgDotVec4(matrix.column_vector[2], matrix.column_vector[2]));
-
-	//Get the rotation vectors, apply inverse scaling
-	vec4 X = linalgNormalizeVec4(matrix.column_vector[0]);
-	X.vector = _mm_mul_ps(X.vector, _mm_set1_ps(1 / a));
-	vec4 Y = linalgNormalizeVec4(matrix.column_vector[1]);
-	Y.vector = _mm_mul_ps(Y.vector, _mm_set1_ps(1 / b));
-	vec4 Z = linalgNormalizeVec4(matrix.column_vector[2]);
-	Z.vector = _mm_mul_ps(Z.vector, _mm_set1_ps(1 / c));
-	vec4 T = linalgNormalizeVec4(matrix.column_vector[3]);
-	T.vector = _mm_mul_ps(T.vector, _mm_set1_ps(-1));
-
-	mat4 inverse;
-
-	//Column adjustments
-	inverse.column[0] = _mm_setr_ps(X.data[0], Y.data[0], Z.data[0], 0);
-	inverse.column[1] = _mm_setr_ps(X.data[1], Y.data[1], Z.data[1], 0);
-	inverse.column[2] = _mm_setr_ps(X.data[2], Y.data[2], Z.data[2], 0);
-	inverse.column[3] = _mm_setr_ps(linalgDotVec4(X, T), linalgDotVec4(Y, T), linalgDotVec4(Z, T), 1);
-
-	return inverse;
-}
-
-/*-------- Quaternion Operations ----------*/
-
-quat linalgMakeQuaternionFromComponents(float x, float y, float z, float w) {
-	quat q;
-
-	q.vector = _mm_setr_ps(x, y, z, w);
-
-	return q;
-}
-
-quat linalgMakeQuaternionFromRotation(float angle, vec3 axis) {
-	quat q;
-
-	axis = linalgNormalizeVec3(axis);
-	float s = sinf(linalgDeg2Rad(angle / 2));
-	float c = cosf(linalgDeg2Rad(angle / 2));
-
-	q.vector = _mm_mul_ps(axis.vector, _mm_set1_ps(s));
-	q.data[3] = c;
-
-	return q;
-}
-
-quat linalgMakeRotationFromVec2Vec(vec3 a, vec3 b) {
-
-	a = linalgNormalizeVec3(a);
-	b = linalgNormalizeVec3(b);
-
-	// a and b might be antiparallel
-	if (linalgCloseVec3(a, linalgMulVec3(b, -1.0f))) {
-
-		//we want to rotate around a to get to b,
-		//pick the least dominant component as the rotation direction
-		vec3 ortho = linalgMakeVec3(1, 0, 0);
-		if (fabsf(a.data[1]) < fabs(a.data[0])) {
-			ortho = linalgMakeVec3(0, 1, 0);
-		}
-		if (fabsf(a.data[2]) < fminf(fabs(a.data[0]), fabs(a.data[1]))) {
-			ortho = linalgMakeVec3(0, 0, 1);
-		}
-		vec3 axis = linalgNormalizeVec3(linalgCross(a, ortho));
-		return linalgMakeQuaternionFromComponents(
-			axis.data[0], 
-			axis.data[1], 
-			axis.data[2], 
-			0.0f
-		);
-	}
-
-	//Construct the regular quaternion
-	vec3 halfVec = linalgNormalizeVec3(linalgAddVec3(a, b));
-	vec3 axis = linalgCross(a, halfVec);
-	return linalgMakeQuaternionFromComponents(
-		axis.data[0], 
-		axis.data[1], 
-		axis.data[2], 
-		linalgDotVec3(a, halfVec)
-	);
-}
-
-vec3 linalgGetAxisFromQuaternion(quat q) {
-	return linalgNormalizeVec3(linalgMakeVec3(q.data[0], q.data[1], q.data[2]));
-}
-
-float linalgGetAngleFromQuaternion(quat q) {
-	return linalgRad2Deg(2.0f * acosf(q.data[3]));
-}
-
-quat linalgAddQuat(quat q1, quat q2) {
-	quat result;
-
-	result.vector = _mm_add_ps(q1.vector, q2.vector);
-
-	return result;
-}
-
-quat linalgSubQuat(quat q1, quat q2) {
-	quat result;
-
-	result.vector = _mm_sub_ps(q1.vector, q2.vector);
-
-	return result;
-}
-
-quat linalgMulQuat(quat q, float scalar) {
-	quat result;
-
-	result.vector = _mm_mul_ps(q.vector, _mm_set1_ps(scalar));
-
-	return result;
-}
-
-float linalgDotQuat(quat q1, quat q2) {
-	return q1.data[0] * q2.data[0]
-		+ q1.data[1] * q2.data[1]
-		+ q1.data[2] * q2.data[2]
-		+ q1.data[3] * q2.data[3];
-}
-
-bool linalgCloseQuat(quat q1, quat q2) {
-
-	quat displacement = linalgSubQuat(q2, q1);
-
-	return linalgDotQuat(displacement, displacement) < eps;
-}
-
-bool linalgQuatSameOrientation(quat q1, quat q2) {
-
-	quat displacement = linalgSubQuat(q1, q2);
-
-	if (linalgDotQuat(displacement, displacement) < eps) {
-		return true;
-	}
-
-	displacement = linalgAddQuat(q1, q2);
-
-	if (linalgDotQuat(displacement, displacement) < eps) {
-		return true;
-	}
-
-	return false;
-}
-
-quat linalgNormalizeQuat(quat q) {
-
-	float scalar = 1 / sqrtf(linalgDotQuat(q, q));
-
-	return linalgMulQuat(q, scalar);
-}
-
-quat linalgGetConjQuat(quat q) {
-
-	return linalgMakeQuaternionFromComponents(
-		-q.data[0],
-		-q.data[1],
-		-q.data[2],
-		q.data[3]
-	);
-}
-
-quat linalgInvQuat(quat q) {
-
-	return linalgMulQuat(linalgGetConjQuat(q), 1 / linalgDotQuat(q, q));
+﻿#include "linear_algebros.h"
+#include <math.h>
+#include <string.h>
+
+frustrum linalgMakeViewFrustrum(float fovy, float aspect, float near, float far) {
+	frustrum f;
+	float ytop = fabsf(near) * tanf(linalgDeg2Rad(fovy / 2));
+	float xright = ytop * aspect;
+
+	//near
+	vec3 p0 = linalgMakeVec3(0, 0, near);
+	vec3 n = linalgMakeVec3(0, 0, -1);
+	f.planes[0] = linalgMakePlane(p0, n);
+
+	//far
+	p0 = linalgMakeVec3(0, 0, far);
+	n = linalgMakeVec3(0, 0, 1);
+	f.planes[1] = linalgMakePlane(p0, n);
+
+	//top
+	p0 = linalgMakeVec3(0, ytop, near);
+	n = linalgMakeVec3(0, near / ytop, -1);
+	f.planes[2] = linalgMakePlane(p0, n);
+
+	//bottom
+	p0 = linalgMakeVec3(0, -ytop, near);
+	n = linalgMakeVec3(0, -near / ytop, -1);
+	f.planes[3] = linalgMakePlane(p0, n);
+
+	//left
+	p0 = linalgMakeVec3(-xright, 0, near);
+	n = linalgMakeVec3(-near / xright, 0, -1);
+	f.planes[4] = linalgMakePlane(p0, n);
+
+	//right
+	p0 = linalgMakeVec3(xright, 0, near);
+	n = linalgMakeVec3(near / xright, 0, -1);
+	f.planes[5] = linalgMakePlane(p0, n);
+
+	return f;
+}
+
+edgeTable linalgFrustrumClipSimple(edgeTable input, frustrum f) {
+
+	for (int i = 0; i < 6; ++i) {
+		input = linalgClipAgainstBoundary(input, f.planes[i]);
+	}
+
+	return input;
+}
+
+plane linalgMakePlane(vec3 p0, vec3 n) {
+
+	n = linalgNormalizeVec3(n);
+
+	plane p;
+	p.A = n.data[0];
+	p.B = n.data[1];
+	p.C = n.data[2];
+
+	p.D = -linalgDotVec3(p0, n);
+
+	return p;
+}
+
+bool linalgPointBehindPlane(vec4 v, plane p) {
+	return p.A * v.data[0] + p.B * v.data[1] + p.C * v.data[2] + p.D < 0;
+}
+
+float linalgEdgePlaneIntersectionPoint(vec4 a, vec4 b, plane p) {
+	return -(a.data[0] * p.A + a.data[1] * p.B + a.data[2] * p.C + p.D) /
+		(p.A * (b.data[0] - a.data[0]) + p.B * (b.data[1] - a.data[1]) + p.C * (b.data[2] - a.data[2]));
+}
+
+edgeTable linalgClipAgainstBoundary(edgeTable input, plane p) {
+
+	edgeTable output;
+	output.vertices = (vec4*)malloc(2 * input.vertexCount * sizeof(vec4));
+	output.vertexCount = 0;
+
+	for (int i = 0; i < input.vertexCount; ++i) {
+		vec4 a = input.vertices[i];
+		vec4 b = input.vertices[(i + 1) % input.vertexCount];
+		vec4 c;
+		float t = linalgEdgePlaneIntersectionPoint(a, b, p);
+		c.vector = _mm_fmadd_ps(
+			_mm_set1_ps(t),
+			_mm_sub_ps(b.vector, a.vector),
+			a.vector
+		);
+
+		if (!linalgPointBehindPlane(b, p)) { //if b inside of boundary
+			if (linalgPointBehindPlane(a, p)) { // if a outside of boundary
+				output.vertices[output.vertexCount++] = c;
+			}
+			output.vertices[output.vertexCount++] = b;
+		}
+		else if (!linalgPointBehindPlane(a, p)) { //if a is visible
+			output.vertices[output.vertexCount++] = c;
+		}
+	}
+
+	free(input.vertices);
+	return output;
+}
+
+edgeTable linalgFrustrumClip(edgeTable input, frustrum f) {
+
+	for (int i = 0; i < 6; ++i) {
+		input = linalgClipAgainstBoundaryWithAttributes(input, f.planes[i]);
+	}
+
+	return input;
+}
+
+edgeTable linalgClipAgainstBoundaryWithAttributes(edgeTable input, plane p) {
+
+	edgeTable output;
+	output.vertices = (vec4*)malloc(2 * input.vertexCount * sizeof(vec4));
+	output.payloads = (payload*)malloc(2 * input.vertexCount * sizeof(payload));
+	output.vertexCount = 0;
+
+	for (int i = 0; i < input.vertexCount; ++i) {
+		vec4 a = input.vertices[i];
+		vec4 b = input.vertices[(i + 1) % input.vertexCount];
+		vec4 c;
+		float t = linalgEdgePlaneIntersectionPoint(a, b, p);
+		c.vector = _mm_fmadd_ps(
+			_mm_set1_ps(t),
+			_mm_sub_ps(b.vector, a.vector),
+			a.vector
+		);
+
+		payload payload_a, payload_b, payload_c;
+		payload_a = input.payloads[i];
+		payload_b = input.payloads[(i + 1) % input.vertexCount];
+		payload_c.lump = _mm256_fmadd_ps(
+			_mm256_set1_ps(t),
+			_mm256_sub_ps(payload_b.lump, payload_a.lump),
+			payload_a.lump
+		);
+
+		if (!linalgPointBehindPlane(b, p)) { //if b inside of boundary
+			if (linalgPointBehindPlane(a, p)) { // if a outside of boundary
+				output.vertices[output.vertexCount] = c;
+				output.payloads[output.vertexCount++] = payload_c;
+			}
+			output.vertices[output.vertexCount] = b;
+			output.payloads[output.vertexCount++] = payload_b;
+		}
+		else if (!linalgPointBehindPlane(a, p)) { //if a is visible
+			output.vertices[output.vertexCount] = c;
+			output.payloads[output.vertexCount++] = payload_c;
+		}
+	}
+
+	free(input.vertices);
+	free(input.payloads);
+	return output;
+}
+
+//signed distance of a point from a plane (A, B, C, D), negative is outside.
+//view space points are taken to have w = 1, clip space planes scale D by w
+static float linalgClipDistance(vec4 v, vec4 p, bool homogeneous) {
+	float w = homogeneous ? v.data[3] : 1.0f;
+	return p.data[0] * v.data[0] + p.data[1] * v.data[1] + p.data[2] * v.data[2] + p.data[3] * w;
+}
+
+static void linalgClipAgainstPlaneFixed(const fixedEdgeTable* input, fixedEdgeTable* output,
+	vec4 p, bool homogeneous, bool withAttributes) {
+
+	output->vertexCount = 0;
+
+	if (input->vertexCount == 0) {
+		return;
+	}
+
+	float distance[maxClipVertices];
+	for (int i = 0; i < input->vertexCount; ++i) {
+		distance[i] = linalgClipDistance(input->vertices[i], p, homogeneous);
+	}
+
+	for (int i = 0; i < input->vertexCount; ++i) {
+
+		int k = (i + 1) % input->vertexCount;
+		bool a_inside = distance[i] >= 0;
+		bool b_inside = distance[k] >= 0;
+
+		//the edge crosses the plane, emit the intersection
+		if (a_inside != b_inside) {
+			float t = distance[i] / (distance[i] - distance[k]);
+			output->vertices[output->vertexCount].vector = _mm_fmadd_ps(
+				_mm_set1_ps(t),
+				_mm_sub_ps(input->vertices[k].vector, input->vertices[i].vector),
+				input->vertices[i].vector
+			);
+			if (withAttributes) {
+				output->payloads[output->vertexCount].lump = _mm256_fmadd_ps(
+					_mm256_set1_ps(t),
+					_mm256_sub_ps(input->payloads[k].lump, input->payloads[i].lump),
+					input->payloads[i].lump
+				);
+			}
+			output->vertexCount++;
+		}
+
+		if (b_inside) {
+			output->vertices[output->vertexCount] = input->vertices[k];
+			if (withAttributes) {
+				output->payloads[output->vertexCount] = input->payloads[k];
+			}
+			output->vertexCount++;
+		}
+	}
+}
+
+static void linalgClipAgainstPlanesFixed(fixedEdgeTable* polygon, const vec4* planes,
+	bool homogeneous, bool withAttributes) {
+
+	//one bit per plane, set if any corner is outside of it (or all of them are)
+	int anyOutside = 0;
+	int allOutside = (1 << 6) - 1;
+
+	for (int i = 0; i < polygon->vertexCount; ++i) {
+		int outside = 0;
+		for (int j = 0; j < 6; ++j) {
+			if (linalgClipDistance(polygon->vertices[i], planes[j], homogeneous) < 0) {
+				outside |= 1 << j;
+			}
+		}
+		anyOutside |= outside;
+		allOutside &= outside;
+	}
+
+	//trivial accept
+	if (anyOutside == 0) {
+		return;
+	}
+
+	//trivial reject
+	if (allOutside != 0) {
+		polygon->vertexCount = 0;
+		return;
+	}
+
+	//only the planes which actually cut the polygon need a pass
+	fixedEdgeTable scratch;
+	fixedEdgeTable* tables[2] = { polygon, &scratch };
+	int current = 0;
+
+	for (int j = 0; j < 6; ++j) {
+		if (anyOutside & (1 << j)) {
+			linalgClipAgainstPlaneFixed(tables[current], tables[1 - current], planes[j], homogeneous, withAttributes);
+			current = 1 - current;
+		}
+	}
+
+	if (current == 1) {
+		polygon->vertexCount = scratch.vertexCount;
+		memcpy(polygon->vertices, scratch.vertices, scratch.vertexCount * sizeof(vec4));
+		if (withAttributes) {
+			memcpy(polygon->payloads, scratch.payloads, scratch.vertexCount * sizeof(payload));
+		}
+	}
+}
+
+void linalgFrustrumClipFixed(fixedEdgeTable* polygon, frustrum f, bool withAttributes) {
+
+	vec4 planes[6];
+	for (int j = 0; j < 6; ++j) {
+		planes[j].vector = _mm_setr_ps(f.planes[j].A, f.planes[j].B, f.planes[j].C, f.planes[j].D);
+	}
+
+	linalgClipAgainstPlanesFixed(polygon, planes, false, withAttributes);
+}
+
+void linalgClipAgainstBoundaryFixed(const fixedEdgeTable* input, fixedEdgeTable* output, plane p, bool withAttributes) {
+
+	vec4 boundary;
+	boundary.vector = _mm_setr_ps(p.A, p.B, p.C, p.D);
+	linalgClipAgainstPlaneFixed(input, output, boundary, false, withAttributes);
+}
+
+void linalgClipSpaceClipFixed(fixedEdgeTable* polygon, float guardBand, bool withAttributes) {
+
+	//inside means -w <= z <= w and -gw <= x, y <= gw
+	vec4 planes[6] = {
+		{ 0.0f,  0.0f,  1.0f, 1.0f},		//near
+		{ 0.0f,  0.0f, -1.0f, 1.0f},		//far
+		{ 1.0f,  0.0f,  0.0f, guardBand},	//left
+		{-1.0f,  0.0f,  0.0f, guardBand},	//right
+		{ 0.0f,  1.0f,  0.0f, guardBand},	//bottom
+		{ 0.0f, -1.0f,  0.0f, guardBand}	//top
+	};
+
+	linalgClipAgainstPlanesFixed(polygon, planes, true, withAttributes);
+}
+
+edgeTable linalgViewFixedEdgeTable(fixedEdgeTable* polygon) {
+
+	edgeTable view;
+	view.vertices = polygon->vertices;
+	view.payloads = polygon->payloads;
+	view.vertexCount = polygon->vertexCount;
+	return view;
+}
+
+payload linalgMakePerspectivePayload(payload attributes, float w) {
+
+	payload result;
+	float oneOverW = 1.0f / w;
+	result.lump = _mm256_mul_ps(attributes.lump, _mm256_set1_ps(oneOverW));
+	result.data[5] = attributes.data[5];
+	result.data[7] = oneOverW;
+	return result;
+}
+
+/*-------- Conversions        ----------*/
+
+float linalgDeg2Rad(float angle) {
+	return angle * pi / 180.0f;
+}
+
+float linalgRad2Deg(float angle) {
+	return angle * 180.0f / pi;
+}
+
+/*-------- Vec3 Operations    ----------*/
+
+vec3 linalgMakeVec3(float x, float y, float z) {
+
+	vec3 result;
+
+	result.data[0] = x;
+	result.data[1] = y;
+	result.data[2] = z;
+	result.data[3] = 0;
+
+	return result;
+}
+
+float linalgDotVec3(vec3 a, vec3 b) {
+	return a.data[0] * b.data[0] + a.data[1] * b.data[1] + a.data[2] * b.data[2];
+}
+
+vec3 linalgCross(vec3 a, vec3 b) {
+	vec3 result;
+
+	result.data[0] = a.data[1] * b.data[2] - a.data[2] * b.data[1];
+	result.data[1] = a.data[2] * b.data[0] - a.data[0] * b.data[2];
+	result.data[2] = a.data[0] * b.data[1] - a.data[1] * b.data[0];
+	result.data[3] = 0;
+
+	return result;
+}
+
+vec3 linalgNormalizeVec3(vec3 a) {
+
+	float invMagnitude = 1.0f / sqrtf(a.data[0] * a.data[0] + a.data[1] * a.data[1] + a.data[2] * a.data[2]);
+
+	vec3 result;
+
+	result.vector = _mm_mul_ps(a.vector, _mm_set1_ps(invMagnitude));
+
+	return result;
+}
+
+vec3 linalgSubVec3(vec3 a, vec3 b) {
+	
+	vec3 result;
+
+	result.vector = _mm_sub_ps(a.vector, b.vector);
+
+	return result;
+}
+
+vec3 linalgAddVec3(vec3 a, vec3 b) {
+
+	vec3 result;
+
+	result.vector = _mm_add_ps(a.vector, b.vector);
+
+	return result;
+}
+
+vec3 linalgMulVec3(vec3 a, float scalar) {
+
+	vec3 result;
+
+	result.vector = _mm_mul_ps(a.vector, _mm_set1_ps(scalar));
+
+	return result;
+}
+
+float linalgAngleBetweenVectors3(vec3 a, vec3 b) {
+
+	float denominator = sqrtf(linalgDotVec3(a, a) * linalgDotVec3(b, b));
+
+	float dot = linalgDotVec3(a, b);
+
+	return linalgRad2Deg(acosf(dot / denominator));
+}
+
+vec3 linalgProject(vec3 incoming, vec3 basis) {
+
+	return linalgMulVec3(basis, linalgDotVec3(incoming, basis) / linalgDotVec3(basis, basis));
+}
+
+vec3 linalgReject(vec3 incoming, vec3 basis) {
+	
+	return linalgSubVec3(incoming, linalgProject(incoming, basis));
+}
+
+vec3 linalgReflect(vec3 incident, vec3 normal) {
+
+	vec3 result;
+	// reflected = incident − 2(incident.normal)normal
+	result.vector = _mm_fmadd_ps(
+		normal.vector, 
+		_mm_set1_ps(-2.0f * linalgDotVec3(incident, normal)),
+		incident.vector
+	);
+
+	return result;
+}
+
+vec3 linalgLerpVec3(vec3 a, vec3 b, float t) {
+
+	vec3 result;
+
+	result.vector = _mm_fmadd_ps(
+		_mm_sub_ps(b.vector, a.vector),
+		_mm_set1_ps(t),
+		a.vector
+	);
+
+	return result;
+}
+
+vec3 linalgSlerpVec3(vec3 a, vec3 b, float t) {
+
+	if (t < 0.1f) {
+		return linalgLerpVec3(a, b, t);
+	}
+
+	float angle = linalgAngleBetweenVectors3(a, b);
+
+	float denominator = sinf(linalgDeg2Rad(angle));
+
+	vec3 result;
+
+	result.vector = _mm_fmadd_ps(
+		a.vector,
+		_mm_set1_ps(sinf(1 - t) * angle / denominator),
+		_mm_mul_ps(b.vector, _mm_set1_ps(sinf(t * angle) / denominator))
+	);
+
+	return result;
+}
+
+vec3 linalgNlerpVec3(vec3 a, vec3 b, float t) {
+
+	return linalgNormalizeVec3(linalgLerpVec3(a, b, t));
+}
+
+bool linalgCloseVec3(vec3 a, vec3 b) {
+	
+	vec3 displacement = linalgSubVec3(a, b);
+
+	return linalgDotVec3(displacement, displacement) < eps;
+}
+
+/*-------- Vector4 Operations ----------*/
+
+float linalgDotVec4(vec4 a, vec4 b) {
+	return a.data[0] * b.data[0] + a.data[1] * b.data[1] + a.data[2] * b.data[2] + a.data[3] * b.data[3];
+}
+
+vec4 linalgNormalizeVec4(vec4 a) {
+
+	float invMagnitude = 1.0f / sqrtf(
+		a.data[0] * a.data[0] + a.data[1] * a.data[1] + a.data[2] * a.data[2] + a.data[3] * a.data[3]
+	);
+
+	vec4 result;
+
+	result.vector = _mm_mul_ps(a.vector, _mm_set1_ps(invMagnitude));
+
+	return result;
+}
+
+/*-------- Matrix4 Operations ----------*/
+
+mat4 linalgMakeIdentity4() {
+	mat4 result;
+
+	result.column[0] = _mm_setr_ps(1, 0, 0, 0);
+	result.column[1] = _mm_setr_ps(0, 1, 0, 0);
+	result.column[2] = _mm_setr_ps(0, 0, 1, 0);
+	result.column[3] = _mm_setr_ps(0, 0, 0, 1);
+
+	return result;
+}
+
+mat4 linalgMakePerspectiveProjection(
+	float fovy, float aspect, float near, float far) {
+
+	float yMax = near * tanf(linalgDeg2Rad(fovy / 2));
+	float xMax = yMax * aspect;
+
+	/*
+	
+		The matrix is:
+
+		[E 0  A 0]
+		[0 F  B 0]
+		[0 0  C D]
+		[0 0 -1 0]
+
+		Given by:
+
+		float left{ -xMax };
+		float right{ -xMax };
+		float top{ -yMax };
+		float bottom{ yMax };
+
+		float A{ (right + left) / (right - left) };
+		float B{ (top + bottom) / (top - bottom) };
+		float C{ -(far + near) / (far - near) };
+		float D{ -2.0f * far * near / (far - near) };
+		float E{ 2.0f * near / (right - left) };
+		float F{ 2.0f * near / (top - bottom) };
+
+		(In practice this simplifies out quite a bit though.)
+	*/
+	float C = -(far + near) / (far - near);
+	float D = -2.0f * far * near / (far - near);
+	float E = near / xMax;
+	float F = near / yMax;
+
+	mat4 result;
+
+	result.column[0] = _mm_setr_ps(E, 0, 0,  0);
+	result.column[1] = _mm_setr_ps(0, F, 0,  0);
+	result.column[2] = _mm_setr_ps(0, 0, C, -1);
+	result.column[3] = _mm_setr_ps(0, 0, D,  0);
+
+	return result;
+}
+
+mat4 linalgMakeLookAt(vec3 eye, vec3 target, vec3 up) {
+
+	vec3 forwards = linalgNormalizeVec3(linalgSubVec3(target, eye));
+	vec3 right = linalgNormalizeVec3(linalgCross(forwards, up));
+	up = linalgNormalizeVec3(linalgCross(right, forwards));
+
+	forwards = linalgMulVec3(forwards, -1);
+
+	mat4 result;
+
+	result.column[0] = _mm_setr_ps(right.data[0], up.data[0], forwards.data[0], 0);
+	result.column[1] = _mm_setr_ps(right.data[1], up.data[1], forwards.data[1], 0);
+	result.column[2] = _mm_setr_ps(right.data[2], up.data[2], forwards.data[2], 0);
+	result.column[3] = _mm_setr_ps(-linalgDotVec3(right, eye), -linalgDotVec3(up, eye), -linalgDotVec3(forwards, eye), 1);
+
+	return result;
+}
+
+mat4 linalgMakeTranslation(vec3 translation) {
+
+	mat4 result;
+
+	result.column[0] = _mm_setr_ps(1, 0, 0, 0);
+	result.column[1] = _mm_setr_ps(0, 1, 0, 0);
+	result.column[2] = _mm_setr_ps(0, 0, 1, 0);
+	result.column[3] = _mm_setr_ps(translation.data[0], translation.data[1], translation.data[2], 1);
+
+	return result;
+}
+
+mat4 linalgMakeXRotation(float angle) {
+
+	angle = linalgDeg2Rad(angle);
+	float cT = cosf(angle);
+	float sT = sinf(angle);
+
+	mat4 result;
+
+	result.column[0] = _mm_setr_ps(1,  0,   0, 0);
+	result.column[1] = _mm_setr_ps(0, cT, -sT, 0);
+	result.column[2] = _mm_setr_ps(0, sT,  cT, 0);
+	result.column[3] = _mm_setr_ps(0,  0,   0, 1);
+
+	return result;
+}
+
+mat4 linalgMakeYRotation(float angle) {
+
+	angle = linalgDeg2Rad(angle);
+	float cT = cosf(angle);
+	float sT = sinf(angle);
+
+	mat4 result;
+
+	result.column[0] = _mm_setr_ps( cT, 0, sT, 0);
+	result.column[1] = _mm_setr_ps(  0, 1,  0, 0);
+	result.column[2] = _mm_setr_ps(-sT, 0, cT, 0);
+	result.column[3] = _mm_setr_ps(  0, 0,  0, 1);
+
+	return result;
+}
+
+mat4 linalgMakeZRotation(float angle) {
+
+	angle = linalgDeg2Rad(angle);
+	float cT = cosf(angle);
+	float sT = sinf(angle);
+
+	mat4 result;
+
+	result.column[0] = _mm_setr_ps(cT, -sT, 0, 0);
+	result.column[1] = _mm_setr_ps(sT,  cT, 0, 0);
+	result.column[2] = _mm_setr_ps( 0,   0, 1, 0);
+	result.column[3] = _mm_setr_ps( 0,   0, 0, 1);
+
+	return result;
+}
+
+vec4 linalgMulMat4Vec4(mat4 m, vec4 v) {
+
+	vec4 result;
+
+	result.vector = _mm_fmadd_ps(_mm_set1_ps(v.data[0]), m.column[0],
+					_mm_fmadd_ps(_mm_set1_ps(v.data[1]), m.column[1],
+					_mm_fmadd_ps(_mm_set1_ps(v.data[2]), m.column[2],
+					_mm_mul_ps(_mm_set1_ps(v.data[3]), m.column[3])
+					)
+				)
+	);
+
+	return result;
+}
+
+viewportTransform linalgMakeViewportTransform(int width, int height) {
+
+	viewportTransform viewport;
+
+	viewport.centerX = 0.5f * width;
+	viewport.centerY = 0.5f * height;
+	viewport.scaleX = 0.5f * width;
+	viewport.scaleY = -0.5f * height;
+
+	return viewport;
+}
+
+void linalgTransformVertexStream(const mat4* m, const vertexStream* input, vertexStream* output) {
+
+	//broadcast each matrix element once, rather than once per vertex
+	__m256 elements[16];
+	for (int i = 0; i < 16; ++i) {
+		elements[i] = _mm256_set1_ps(m->data[i]);
+	}
+
+	int i = 0;
+	for (; i + 8 <= input->count; i += 8) {
+
+		__m256 x = _mm256_loadu_ps(input->x + i);
+		__m256 y = _mm256_loadu_ps(input->y + i);
+		__m256 z = _mm256_loadu_ps(input->z + i);
+		__m256 w = _mm256_loadu_ps(input->w + i);
+
+		//m is column major: row r of the result is x*m[r] + y*m[4 + r] + z*m[8 + r] + w*m[12 + r]
+		__m256 resultX = _mm256_fmadd_ps(x, elements[0], _mm256_fmadd_ps(y, elements[4], _mm256_fmadd_ps(z, elements[8], _mm256_mul_ps(w, elements[12]))));
+		__m256 resultY = _mm256_fmadd_ps(x, elements[1], _mm256_fmadd_ps(y, elements[5], _mm256_fmadd_ps(z, elements[9], _mm256_mul_ps(w, elements[13]))));
+		__m256 resultZ = _mm256_fmadd_ps(x, elements[2], _mm256_fmadd_ps(y, elements[6], _mm256_fmadd_ps(z, elements[10], _mm256_mul_ps(w, elements[14]))));
+		__m256 resultW = _mm256_fmadd_ps(x, elements[3], _mm256_fmadd_ps(y, elements[7], _mm256_fmadd_ps(z, elements[11], _mm256_mul_ps(w, elements[15]))));
+
+		_mm256_storeu_ps(output->x + i, resultX);
+		_mm256_storeu_ps(output->y + i, resultY);
+		_mm256_storeu_ps(output->z + i, resultZ);
+		_mm256_storeu_ps(output->w + i, resultW);
+	}
+
+	//leftovers
+	for (; i < input->count; ++i) {
+		vec4 v;
+		v.vector = _mm_setr_ps(input->x[i], input->y[i], input->z[i], input->w[i]);
+		v = linalgMulMat4Vec4(*m, v);
+		output->x[i] = v.data[0];
+		output->y[i] = v.data[1];
+		output->z[i] = v.data[2];
+		output->w[i] = v.data[3];
+	}
+}
+
+void linalgProjectVertexStream(const mat4* m, const vertexStream* input, viewportTransform viewport, vertexStream* output) {
+
+	__m256 elements[16];
+	for (int i = 0; i < 16; ++i) {
+		elements[i] = _mm256_set1_ps(m->data[i]);
+	}
+	__m256 centerX = _mm256_set1_ps(viewport.centerX);
+	__m256 centerY = _mm256_set1_ps(viewport.centerY);
+	__m256 scaleX = _mm256_set1_ps(viewport.scaleX);
+	__m256 scaleY = _mm256_set1_ps(viewport.scaleY);
+	__m256 one = _mm256_set1_ps(1.0f);
+
+	int i = 0;
+	for (; i + 8 <= input->count; i += 8) {
+
+		__m256 x = _mm256_loadu_ps(input->x + i);
+		__m256 y = _mm256_loadu_ps(input->y + i);
+		__m256 z = _mm256_loadu_ps(input->z + i);
+		__m256 w = _mm256_loadu_ps(input->w + i);
+
+		__m256 clipX = _mm256_fmadd_ps(x, elements[0], _mm256_fmadd_ps(y, elements[4], _mm256_fmadd_ps(z, elements[8], _mm256_mul_ps(w, elements[12]))));
+		__m256 clipY = _mm256_fmadd_ps(x, elements[1], _mm256_fmadd_ps(y, elements[5], _mm256_fmadd_ps(z, elements[9], _mm256_mul_ps(w, elements[13]))));
+		__m256 clipZ = _mm256_fmadd_ps(x, elements[2], _mm256_fmadd_ps(y, elements[6], _mm256_fmadd_ps(z, elements[10], _mm256_mul_ps(w, elements[14]))));
+		__m256 clipW = _mm256_fmadd_ps(x, elements[3], _mm256_fmadd_ps(y, elements[7], _mm256_fmadd_ps(z, elements[11], _mm256_mul_ps(w, elements[15]))));
+
+		//one division shared by all three coordinates
+		__m256 inverseW = _mm256_div_ps(one, clipW);
+
+		_mm256_storeu_ps(output->x + i, _mm256_fmadd_ps(_mm256_mul_ps(clipX, inverseW), scaleX, centerX));
+		_mm256_storeu_ps(output->y + i, _mm256_fmadd_ps(_mm256_mul_ps(clipY, inverseW), scaleY, centerY));
+		_mm256_storeu_ps(output->z + i, _mm256_mul_ps(clipZ, inverseW));
+		_mm256_storeu_ps(output->w + i, clipW);
+	}
+
+	//leftovers
+	for (; i < input->count; ++i) {
+		vec4 v;
+		v.vector = _mm_setr_ps(input->x[i], input->y[i], input->z[i], input->w[i]);
+		v = linalgMulMat4Vec4(*m, v);
+		float inverseW = 1.0f / v.data[3];
+		output->x[i] = viewport.centerX + viewport.scaleX * v.data[0] * inverseW;
+		output->y[i] = viewport.centerY + viewport.scaleY * v.data[1] * inverseW;
+		output->z[i] = v.data[2] * inverseW;
+		output->w[i] = v.data[3];
+	}
+}
+
+void linalgProjectFixedEdgeTable(fixedEdgeTable* polygon, viewportTransform viewport) {
+
+	__m256 centerX = _mm256_set1_ps(viewport.centerX);
+	__m256 centerY = _mm256_set1_ps(viewport.centerY);
+	__m256 scaleX = _mm256_set1_ps(viewport.scaleX);
+	__m256 scaleY = _mm256_set1_ps(viewport.scaleY);
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 laneIndex = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+	//maxClipVertices is a multiple of 8, so whole batches never run off the end of the storage
+	for (int i = 0; i < polygon->vertexCount; i += 8) {
+
+		vec4* corners = polygon->vertices + i;
+
+		//transpose eight (x, y, z, w) corners into x, y, z and w registers
+		__m256 c04 = _mm256_insertf128_ps(_mm256_castps128_ps256(corners[0].vector), corners[4].vector, 1);
+		__m256 c15 = _mm256_insertf128_ps(_mm256_castps128_ps256(corners[1].vector), corners[5].vector, 1);
+		__m256 c26 = _mm256_insertf128_ps(_mm256_castps128_ps256(corners[2].vector), corners[6].vector, 1);
+		__m256 c37 = _mm256_insertf128_ps(_mm256_castps128_ps256(corners[3].vector), corners[7].vector, 1);
+		__m256 xy01 = _mm256_unpacklo_ps(c04, c15);
+		__m256 zw01 = _mm256_unpackhi_ps(c04, c15);
+		__m256 xy23 = _mm256_unpacklo_ps(c26, c37);
+		__m256 zw23 = _mm256_unpackhi_ps(c26, c37);
+		__m256 x = _mm256_shuffle_ps(xy01, xy23, 0x44);
+		__m256 y = _mm256_shuffle_ps(xy01, xy23, 0xEE);
+		__m256 z = _mm256_shuffle_ps(zw01, zw23, 0x44);
+		__m256 w = _mm256_shuffle_ps(zw01, zw23, 0xEE);
+
+		//corners past the end are junk, keep them from dividing by zero
+		__m256 valid = _mm256_cmp_ps(laneIndex, _mm256_set1_ps((float)(polygon->vertexCount - i)), _CMP_LT_OQ);
+		__m256 inverseW = _mm256_div_ps(one, _mm256_blendv_ps(one, w, valid));
+
+		x = _mm256_fmadd_ps(_mm256_mul_ps(x, inverseW), scaleX, centerX);
+		y = _mm256_fmadd_ps(_mm256_mul_ps(y, inverseW), scaleY, centerY);
+		payload depth;
+		depth.lump = _mm256_mul_ps(z, inverseW);
+
+		//and back again
+		xy01 = _mm256_unpacklo_ps(x, y);
+		xy23 = _mm256_unpackhi_ps(x, y);
+		zw01 = _mm256_unpacklo_ps(z, w);
+		zw23 = _mm256_unpackhi_ps(z, w);
+		c04 = _mm256_shuffle_ps(xy01, zw01, 0x44);
+		c15 = _mm256_shuffle_ps(xy01, zw01, 0xEE);
+		c26 = _mm256_shuffle_ps(xy23, zw23, 0x44);
+		c37 = _mm256_shuffle_ps(xy23, zw23, 0xEE);
+		corners[0].vector = _mm256_castps256_ps128(c04);
+		corners[1].vector = _mm256_castps256_ps128(c15);
+		corners[2].vector = _mm256_castps256_ps128(c26);
+		corners[3].vector = _mm256_castps256_ps128(c37);
+		corners[4].vector = _mm256_extractf128_ps(c04, 1);
+		corners[5].vector = _mm256_extractf128_ps(c15, 1);
+		corners[6].vector = _mm256_extractf128_ps(c26, 1);
+		corners[7].vector = _mm256_extractf128_ps(c37, 1);
+
+		for (int j = 0; j < 8 && i + j < polygon->vertexCount; ++j) {
+			polygon->payloads[i + j].data[5] = depth.data[j];
+		}
+	}
+}
+
+mat4 linalgMulMat4Mat4(mat4 m1, mat4 m2) {
+
+	mat4 result;
+
+	result.column_vector[0] = linalgMulMat4Vec4(m2, m1.column_vector[0]);
+	result.column_vector[1] = linalgMulMat4Vec4(m2, m1.column_vector[1]);
+	result.column_vector[2] = linalgMulMat4Vec4(m2, m1.column_vector[2]);
+	result.column_vector[3] = linalgMulMat4Vec4(m2, m1.column_vector[3]);
+
+	return result;
+}
+
+mat4 linalgAddMat4(mat4 m1, mat4 m2) {
+
+	mat4 m3;
+	m3.chunk[0] = _mm256_add_ps(m1.chunk[0], m2.chunk[0]);
+	m3.chunk[1] = _mm256_add_ps(m1.chunk[1], m2.chunk[1]);
+
+	return m3;
+}
+
+mat4 linalgMulMat4Scalar(mat4 matrix, float scalar) {
+
+	mat4 m3;
+	__m256 scale = _mm256_set1_ps(scalar);
+	m3.chunk[0] = _mm256_mul_ps(matrix.chunk[0], scale);
+	m3.chunk[1] = _mm256_mul_ps(matrix.chunk[1], scale);
+
+	return m3;
+}
+
+mat4 linalgLerpMat4(mat4 m1, mat4 m2, float t) {
+
+	mat4 m3;
+	__m256 scale = _mm256_set1_ps(t);
+
+	m3.chunk[0] = _mm256_fmadd_ps(
+		_mm256_sub_ps(m2.chunk[0], m1.chunk[0]),
+		scale,
+		m1.chunk[0]
+	);
+
+	m3.chunk[1] = _mm256_fmadd_ps(
+		_mm256_sub_ps(m2.chunk[1], m1.chunk[1]),
+		scale,
+		m1.chunk[1]
+	);
+
+	return m3;
+}
+
+mat4 linalgTranspose(mat4 matrix) {
+
+	mat4 transposed;
+
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			transposed.data[i + 4 * j] = matrix.data[j + 4 * i];
+		}
+	}
+
+	return transposed;
+}
+
+mat4 linalgTransformInverse(mat4 matrix) {
+
+	//Get the scale factors
+	float a = sqrtf(linalgDotVec4(matrix.column_vector[0], matrix.column_vector[0]));
+	float b = sqrtf(linalgDotVec4(matrix.column_vector[1], matrix.column_vector[1]));
+	float c = sqrtf(linalgDotVec4(matrix.column_vector[2], matrix.column_vector[2]));
+
+	//Get the rotation vectors, apply inverse scaling
+	vec4 X = linalgNormalizeVec4(matrix.column_vector[0]);
+	X.vector = _mm_mul_ps(X.vector, _mm_set1_ps(1 / a));
+	vec4 Y = linalgNormalizeVec4(matrix.column_vector[1]);
+	Y.vector = _mm_mul_ps(Y.vector, _mm_set1_ps(1 / b));
+	vec4 Z = linalgNormalizeVec4(matrix.column_vector[2]);
+	Z.vector = _mm_mul_ps(Z.vector, _mm_set1_ps(1 / c));
+	vec4 T = linalgNormalizeVec4(matrix.column_vector[3]);
+	T.vector = _mm_mul_ps(T.vector, _mm_set1_ps(-1));
+
+	mat4 inverse;
+
+	//Column adjustments
+	inverse.column[0] = _mm_setr_ps(X.data[0], Y.data[0], Z.data[0], 0);
+	inverse.column[1] = _mm_setr_ps(X.data[1], Y.data[1], Z.data[1], 0);
+	inverse.column[2] = _mm_setr_ps(X.data[2], Y.data[2], Z.data[2], 0);
+	inverse.column[3] = _mm_setr_ps(linalgDotVec4(X, T), linalgDotVec4(Y, T), linalgDotVec4(Z, T), 1);
+
+	return inverse;
+}
+
+/*-------- Quaternion Operations ----------*/
+
+quat linalgMakeQuaternionFromComponents(float x, float y, float z, float w) {
+	quat q;
+
+	q.vector = _mm_setr_ps(x, y, z, w);
+
+	return q;
+}
+
+quat linalgMakeQuaternionFromRotation(float angle, vec3 axis) {
+	quat q;
+
+	axis = linalgNormalizeVec3(axis);
+	float s = sinf(linalgDeg2Rad(angle / 2));
+	float c = cosf(linalgDeg2Rad(angle / 2));
+
+	q.vector = _mm_mul_ps(axis.vector, _mm_set1_ps(s));
+	q.data[3] = c;
+
+	return q;
+}
+
+quat linalgMakeRotationFromVec2Vec(vec3 a, vec3 b) {
+
+	a = linalgNormalizeVec3(a);
+	b = linalgNormalizeVec3(b);
+
+	// a and b might be antiparallel
+	if (linalgCloseVec3(a, linalgMulVec3(b, -1.0f))) {
+
+		//we want to rotate around a to get to b,
+		//pick the least dominant component as the rotation direction
+		vec3 ortho = linalgMakeVec3(1, 0, 0);
+		if (fabsf(a.data[1]) < fabs(a.data[0])) {
+			ortho = linalgMakeVec3(0, 1, 0);
+		}
+		if (fabsf(a.data[2]) < fminf(fabs(a.data[0]), fabs(a.data[1]))) {
+			ortho = linalgMakeVec3(0, 0, 1);
+		}
+		vec3 axis = linalgNormalizeVec3(linalgCross(a, ortho));
+		return linalgMakeQuaternionFromComponents(
+			axis.data[0], 
+			axis.data[1], 
+			axis.data[2], 
+			0.0f
+		);
+	}
+
+	//Construct the regular quaternion
+	vec3 halfVec = linalgNormalizeVec3(linalgAddVec3(a, b));
+	vec3 axis = linalgCross(a, halfVec);
+	return linalgMakeQuaternionFromComponents(
+		axis.data[0], 
+		axis.data[1], 
+		axis.data[2], 
+		linalgDotVec3(a, halfVec)
+	);
+}
+
+vec3 linalgGetAxisFromQuaternion(quat q) {
+	return linalgNormalizeVec3(linalgMakeVec3(q.data[0], q.data[1], q.data[2]));
+}
+
+float linalgGetAngleFromQuaternion(quat q) {
+	return linalgRad2Deg(2.0f * acosf(q.data[3]));
+}
+
+quat linalgAddQuat(quat q1, quat q2) {
+	quat result;
+
+	result.vector = _mm_add_ps(q1.vector, q2.vector);
+
+	return result;
+}
+
+quat linalgSubQuat(quat q1, quat q2) {
+	quat result;
+
+	result.vector = _mm_sub_ps(q1.vector, q2.vector);
+
+	return result;
+}
+
+quat linalgMulQuat(quat q, float scalar) {
+	quat result;
+
+	result.vector = _mm_mul_ps(q.vector, _mm_set1_ps(scalar));
+
+	return result;
+}
+
+float linalgDotQuat(quat q1, quat q2) {
+	return q1.data[0] * q2.data[0]
+		+ q1.data[1] * q2.data[1]
+		+ q1.data[2] * q2.data[2]
+		+ q1.data[3] * q2.data[3];
+}
+
+bool linalgCloseQuat(quat q1, quat q2) {
+
+	quat displacement = linalgSubQuat(q2, q1);
+
+	return linalgDotQuat(displacement, displacement) < eps;
+}
+
+bool linalgQuatSameOrientation(quat q1, quat q2) {
+
+	quat displacement = linalgSubQuat(q1, q2);
+
+	if (linalgDotQuat(displacement, displacement) < eps) {
+		return true;
+	}
+
+	displacement = linalgAddQuat(q1, q2);
+
+	if (linalgDotQuat(displacement, displacement) < eps) {
+		return true;
+	}
+
+	return false;
+}
+
+quat linalgNormalizeQuat(quat q) {
+
+	float scalar = 1 / sqrtf(linalgDotQuat(q, q));
+
+	return linalgMulQuat(q, scalar);
+}
+
+quat linalgGetConjQuat(quat q) {
+
+	return linalgMakeQuaternionFromComponents(
+		-q.data[0],
+		-q.data[1],
+		-q.data[2],
+		q.data[3]
+	);
+}
+
+quat linalgInvQuat(quat q) {
+
+	return linalgMulQuat(linalgGetConjQuat(q), 1 / linalgDotQuat(q, q));
 }
\ No newline at end of file
@@ -1,11 +1,16 @@
-#include "control/app.h"
-
-int main() {
-
-	App* myApp = new App(640, 480, true);
-
-	myApp->run();
-	delete myApp;
-
-	return 0;
+#include "control/app.h"
+
+//an OBJ or mesh file can be given to draw in place of the textured cube
+int main(int argc, char** argv) {
+
+	App* myApp = new App(640, 480, true);
+	if (argc > 1 && !myApp->load_model(argv[1])) {
+		delete myApp;
+		return 1;
+	}
+
+	myApp->run();
+	delete myApp;
+
+	return 0;
 }
\ No newline at end of file
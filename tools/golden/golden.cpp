@@ -0,0 +1,213 @@
+/*
+	Golden image checks for the rasterizer.
+
+	Each of the App's drawing tests is rendered headless at a fixed rotation
+	and compared with a reference image checked in under tools/golden/reference.
+	A scene passes when few enough pixels are off by more than the per pixel
+	tolerance and the whole image stays above the PSNR floor. Failing scenes
+	are written out, along with an amplified difference image. Every scene
+	must also be drawn without overdraw: the cubes are closed and culled, so
+	a pixel covered twice means neighbouring faces disagree about an edge.
+	Each scene is also drawn twice with dirty tile tracking, turned a little
+	between frames, and the second frame, uploaded only where it changed,
+	must come out exactly like the whole frame drawn at once.
+	Scenes which hide a model behind another must cull some of its polygons
+	before they're clipped, with or without binning.
+
+	Run from the repository root (the tests load tex/floor.png).
+
+	usage: golden [--update] [--reference-paths] [--tolerance levels]
+		[--max-bad fraction] [--psnr dB] [--out directory]
+
+	--update			write the references instead of checking against them,
+						drawn with the reference paths once the fast paths
+						agree with them as closely as a check would require
+	--reference-paths	draw without binning or SIMD spans, to check the fast
+						paths and the straightforward ones agree on the same images
+*/
+#include "../../control/app.h"
+#include "png_writer.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+	struct scene {
+		const char* name;
+		void (App::*test)();
+		//whether something in the scene is hidden and should be culled
+		bool occludes;
+	};
+
+	const scene scenes[] = {
+		{ "lines", &App::lines_test, false },
+		{ "projection", &App::projection_test, false },
+		{ "backface", &App::backface_test, false },
+		{ "clipping", &App::clipping_test, false },
+		{ "flat_shading", &App::flat_shading_test, false },
+		{ "color_blending", &App::color_blending_test, false },
+		{ "texture", &App::texture_test, false },
+		{ "occlusion", &App::occlusion_test, true },
+	};
+
+	const int width = 640, height = 480;
+	//degrees, chosen so every model shows several faces at an angle
+	const float theta = 25.0f;
+
+	struct comparison {
+		int badPixels;
+		double psnr;
+	};
+
+	comparison compare(const unsigned char* frame, const unsigned char* reference, int tolerance, std::vector<unsigned char>& difference) {
+
+		comparison result = { 0, 0.0 };
+		double squaredError = 0.0;
+		difference.assign(4 * width * height, 255);
+
+		for (int i = 0; i < width * height; ++i) {
+			int worst = 0;
+			for (int channel = 0; channel < 3; ++channel) {
+				int error = abs((int)frame[4 * i + channel] - (int)reference[4 * i + channel]);
+				squaredError += error * error;
+				worst = std::max(worst, error);
+				difference[4 * i + channel] = (unsigned char)std::min(255, 16 * error);
+			}
+			result.badPixels += worst > tolerance;
+		}
+
+		double meanSquaredError = squaredError / (3.0 * width * height);
+		result.psnr = meanSquaredError > 0.0 ? 10.0 * log10(255.0 * 255.0 / meanSquaredError) : INFINITY;
+		return result;
+	}
+}
+
+int main(int argc, char** argv) {
+
+	bool update = false, referencePaths = false;
+	int tolerance = 4;
+	double maxBadFraction = 0.001;
+	double minPsnr = 40.0;
+	std::string referenceDirectory = "tools/golden/reference/";
+	std::string outDirectory = "tools/golden/";
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--update")) {
+			update = true;
+		}
+		else if (!strcmp(argv[i], "--reference-paths")) {
+			referencePaths = true;
+		}
+		else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) {
+			tolerance = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--max-bad") && i + 1 < argc) {
+			maxBadFraction = atof(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--psnr") && i + 1 < argc) {
+			minPsnr = atof(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+			outDirectory = std::string(argv[++i]) + "/";
+		}
+		else {
+			std::cout << "usage: " << argv[0] << " [--update] [--reference-paths] [--tolerance levels]"
+				<< " [--max-bad fraction] [--psnr dB] [--out directory]" << std::endl;
+			return 1;
+		}
+	}
+
+	int failures = 0;
+	std::vector<unsigned char> difference;
+
+	for (const scene& test : scenes) {
+
+		//a fresh app per scene, so no state carries over from the last one
+		renderTarget::MemoryTarget target(vk::Format::eR8G8B8A8Unorm);
+		App app(width, height, &target);
+		if (referencePaths || update) {
+			app.use_reference_paths();
+		}
+		app.count_overdraw();
+		app.set_theta(theta);
+		app.draw_frame(test.test);
+		const unsigned char* frame = target.get_last_frame();
+		uint64_t overdraw = app.get_overdraw_count();
+		uint64_t culled = app.get_culled_polygon_count();
+
+		//the frame before only differs where either rotation covers, so that's all that's uploaded
+		renderTarget::MemoryTarget trackedTarget(vk::Format::eR8G8B8A8Unorm);
+		App trackedApp(width, height, &trackedTarget);
+		if (referencePaths || update) {
+			trackedApp.use_reference_paths();
+		}
+		trackedApp.use_dirty_tracking();
+		trackedApp.set_theta(theta - 10.0f);
+		trackedApp.draw_frame(test.test);
+		trackedApp.set_theta(theta);
+		trackedApp.draw_frame(test.test);
+		bool tracked = !memcmp(trackedTarget.get_last_frame(), frame, 4 * width * height);
+		int uploaded = trackedTarget.get_uploaded_pixel_count();
+
+		std::string referenceFile = referenceDirectory + test.name + ".png";
+
+		if (update) {
+			//a reference the fast paths couldn't pass would only hide where they went wrong
+			renderTarget::MemoryTarget fastTarget(vk::Format::eR8G8B8A8Unorm);
+			App fastApp(width, height, &fastTarget);
+			fastApp.set_theta(theta);
+			fastApp.draw_frame(test.test);
+			const unsigned char* fastFrame = fastTarget.get_last_frame();
+
+			comparison agreement = compare(fastFrame, frame, tolerance, difference);
+			if (agreement.badPixels > maxBadFraction * width * height || agreement.psnr < minPsnr) {
+				std::cout << "FAIL " << test.name << ": the fast paths are " << agreement.badPixels
+					<< " pixels off by more than " << tolerance << " from the reference paths, PSNR "
+					<< agreement.psnr << " dB, not written" << std::endl;
+				++failures;
+				golden::write_png(outDirectory + test.name + "_actual.png", fastFrame, width, height);
+				golden::write_png(outDirectory + test.name + "_difference.png", difference.data(), width, height);
+				continue;
+			}
+
+			if (!golden::write_png(referenceFile, frame, width, height)) {
+				std::cout << "Couldn't write " << referenceFile << std::endl;
+				return 1;
+			}
+			std::cout << "Wrote " << referenceFile << std::endl;
+			continue;
+		}
+
+		int referenceWidth, referenceHeight, channels;
+		stbi_uc* reference = stbi_load(referenceFile.c_str(), &referenceWidth, &referenceHeight, &channels, STBI_rgb_alpha);
+		if (!reference || referenceWidth != width || referenceHeight != height) {
+			std::cout << "FAIL " << test.name << ": no usable reference at " << referenceFile << std::endl;
+			free(reference);
+			++failures;
+			continue;
+		}
+
+		comparison result = compare(frame, reference, tolerance, difference);
+		free(reference);
+
+		bool passed = result.badPixels <= maxBadFraction * width * height && result.psnr >= minPsnr && overdraw == 0
+			&& (culled > 0 || !test.occludes) && tracked;
+		std::cout << (passed ? "pass " : "FAIL ") << test.name << ": " << result.badPixels
+			<< " pixels off by more than " << tolerance << ", PSNR " << result.psnr << " dB, "
+			<< overdraw << " fragments overdrawn, " << culled << " polygons culled, "
+			<< uploaded << " pixels uploaded with dirty tracking" << (tracked ? "" : " (different from the whole frame)") << std::endl;
+
+		if (!passed) {
+			++failures;
+			golden::write_png(outDirectory + test.name + "_actual.png", frame, width, height);
+			golden::write_png(outDirectory + test.name + "_difference.png", difference.data(), width, height);
+		}
+	}
+
+	if (!update) {
+		std::cout << (sizeof(scenes) / sizeof(scenes[0])) - failures << " of " << sizeof(scenes) / sizeof(scenes[0])
+			<< " scenes match." << std::endl;
+	}
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,206 @@
+#include "png_writer.h"
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+	/**
+		Packs bits least significant first, as deflate wants them
+	*/
+	class BitWriter {
+
+	public:
+
+		std::vector<unsigned char> bytes;
+
+		void write(uint32_t bits, int count) {
+			for (int i = 0; i < count; ++i) {
+				if (bitCount == 0) {
+					bytes.push_back(0);
+				}
+				bytes.back() |= ((bits >> i) & 1) << bitCount;
+				bitCount = (bitCount + 1) % 8;
+			}
+		}
+
+		//Huffman codes go in most significant bit first
+		void write_code(uint32_t code, int length) {
+			uint32_t reversed = 0;
+			for (int i = 0; i < length; ++i) {
+				reversed |= ((code >> i) & 1) << (length - 1 - i);
+			}
+			write(reversed, length);
+		}
+
+	private:
+
+		int bitCount{ 0 };
+	};
+
+	const int lengthBase[29] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const int lengthExtra[29] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const int distanceBase[30] = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const int distanceExtra[30] = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	//the fixed literal/length code from the deflate spec
+	void write_symbol(BitWriter& out, int symbol) {
+		if (symbol < 144) {
+			out.write_code(0x30 + symbol, 8);
+		}
+		else if (symbol < 256) {
+			out.write_code(0x190 + symbol - 144, 9);
+		}
+		else if (symbol < 280) {
+			out.write_code(symbol - 256, 7);
+		}
+		else {
+			out.write_code(0xc0 + symbol - 280, 8);
+		}
+	}
+
+	void write_match(BitWriter& out, int length, int distance) {
+
+		int code = 28;
+		while (lengthBase[code] > length) {
+			--code;
+		}
+		write_symbol(out, 257 + code);
+		out.write(length - lengthBase[code], lengthExtra[code]);
+
+		code = 29;
+		while (distanceBase[code] > distance) {
+			--code;
+		}
+		out.write_code(code, 5);
+		out.write(distance - distanceBase[code], distanceExtra[code]);
+	}
+
+	/**
+		A zlib stream of one fixed Huffman block, matched greedily against
+		the most recent position with the same three bytes.
+	*/
+	std::vector<unsigned char> deflate(const std::vector<unsigned char>& data) {
+
+		const int window = 32768;
+		const int hashSize = 1 << 16;
+		std::vector<int> lastSeen(hashSize, -1);
+
+		BitWriter out;
+		out.write(0x78, 8);
+		out.write(0x01, 8);
+		//final block, fixed codes
+		out.write(1, 1);
+		out.write(1, 2);
+
+		int size = static_cast<int>(data.size());
+		for (int i = 0; i < size;) {
+
+			int length = 0, distance = 0;
+			if (i + 3 <= size) {
+				uint32_t hash = ((data[i] << 16) | (data[i + 1] << 8) | data[i + 2]) * 2654435761u >> 16;
+				int candidate = lastSeen[hash];
+				lastSeen[hash] = i;
+				if (candidate >= 0 && i - candidate <= window) {
+					while (length < 258 && i + length < size && data[candidate + length] == data[i + length]) {
+						++length;
+					}
+					distance = i - candidate;
+				}
+			}
+
+			if (length >= 3) {
+				write_match(out, length, distance);
+				i += length;
+			}
+			else {
+				write_symbol(out, data[i]);
+				++i;
+			}
+		}
+		write_symbol(out, 256);
+
+		uint32_t a = 1, b = 0;
+		for (unsigned char byte : data) {
+			a = (a + byte) % 65521;
+			b = (b + a) % 65521;
+		}
+		uint32_t adler = (b << 16) | a;
+		for (int shift = 24; shift >= 0; shift -= 8) {
+			out.bytes.push_back((adler >> shift) & 0xff);
+		}
+
+		return out.bytes;
+	}
+
+	uint32_t crc32(const unsigned char* data, size_t size, uint32_t crc = 0) {
+
+		crc = ~crc;
+		for (size_t i = 0; i < size; ++i) {
+			crc ^= data[i];
+			for (int bit = 0; bit < 8; ++bit) {
+				crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1)));
+			}
+		}
+		return ~crc;
+	}
+
+	void write_chunk(std::ofstream& file, const char* type, const std::vector<unsigned char>& data) {
+
+		unsigned char header[8];
+		uint32_t size = static_cast<uint32_t>(data.size());
+		for (int i = 0; i < 4; ++i) {
+			header[i] = (size >> (24 - 8 * i)) & 0xff;
+			header[4 + i] = type[i];
+		}
+		uint32_t crc = crc32(header + 4, 4);
+		crc = crc32(data.data(), data.size(), crc);
+		unsigned char footer[4] = {
+			(unsigned char)(crc >> 24), (unsigned char)(crc >> 16), (unsigned char)(crc >> 8), (unsigned char)crc };
+
+		file.write(reinterpret_cast<const char*>(header), 8);
+		file.write(reinterpret_cast<const char*>(data.data()), data.size());
+		file.write(reinterpret_cast<const char*>(footer), 4);
+	}
+}
+
+bool golden::write_png(const std::string& filename, const unsigned char* pixels, int width, int height) {
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	file.write(reinterpret_cast<const char*>(signature), 8);
+
+	std::vector<unsigned char> header = {
+		(unsigned char)(width >> 24), (unsigned char)(width >> 16), (unsigned char)(width >> 8), (unsigned char)width,
+		(unsigned char)(height >> 24), (unsigned char)(height >> 16), (unsigned char)(height >> 8), (unsigned char)height,
+		//8 bit RGB, default compression and filtering, not interlaced
+		8, 2, 0, 0, 0 };
+	write_chunk(file, "IHDR", header);
+
+	//every row unfiltered
+	std::vector<unsigned char> rows;
+	rows.reserve((size_t)(3 * width + 1) * height);
+	for (int y = 0; y < height; ++y) {
+		rows.push_back(0);
+		for (int x = 0; x < width; ++x) {
+			const unsigned char* pixel = pixels + 4 * ((size_t)width * y + x);
+			rows.insert(rows.end(), pixel, pixel + 3);
+		}
+	}
+	write_chunk(file, "IDAT", deflate(rows));
+	write_chunk(file, "IEND", {});
+
+	return static_cast<bool>(file);
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+
+namespace golden {
+
+	/**
+		Write 8 bit RGB pixels to a PNG file. The encoder is small rather
+		than thorough (fixed Huffman codes, greedy matching), but the mostly
+		flat frames the tests draw still shrink a lot.
+
+		\param filename the file to write
+		\param pixels the pixels, 4 bytes each in RGBA order, alpha is dropped
+		\param width the width of the image (in pixels)
+		\param height the height of the image (in pixels)
+		\returns whether the file could be written
+	*/
+	bool write_png(const std::string& filename, const unsigned char* pixels, int width, int height);
+}
@@ -1,1086 +1,2409 @@
-#include "engine.h"
-#include "vkInit/instance.h"
-#include "vkInit/device.h"
-#include "vkInit/swapchain.h"
-#include "vkInit/commands.h"
-#include "vkInit/sync.h"
-#include "graphics_library.h"
-
-Engine::Engine(int width, int height, GLFWwindow* window) {
-
-	this->width = width;
-	this->height = height;
-	this->window = window;
-
-	vkLogging::Logger::get_logger()->print("Making a graphics engine...");
-
-	make_instance();
-
-	make_device();
-
-	finalize_setup();
-
-}
-
-void Engine::make_instance() {
-
-	instance = vkInit::make_instance("ID Tech 12");
-	dldi = vk::DispatchLoaderDynamic(instance, vkGetInstanceProcAddr);
-	if (vkLogging::Logger::get_logger()->get_debug_mode()) {
-		debugMessenger = vkLogging::make_debug_messenger(instance, dldi);
-	}
-	VkSurfaceKHR c_style_surface;
-	if (glfwCreateWindowSurface(instance, window, nullptr, &c_style_surface) != VK_SUCCESS) {
-		vkLogging::Logger::get_logger()->print("Failed to abstract glfw surface for Vulkan.");
-	}
-	else {
-		vkLogging::Logger::get_logger()->print(
-			"Successfully abstracted glfw surface for Vulkan.");
-	}
-	//copy constructor converts to hpp convention
-	surface = c_style_surface;
-}
-
-void Engine::make_device() {
-
-	physicalDevice = vkInit::choose_physical_device(instance);
-	device = vkInit::create_logical_device(physicalDevice, surface);
-	std::array<vk::Queue,2> queues = vkInit::get_queues(physicalDevice, device, surface);
-	graphicsQueue = queues[0];
-	presentQueue = queues[1];
-	make_swapchain();
-	frameNumber = 0;
-}
-
-/**
-* Make a swapchain
-*/
-void Engine::make_swapchain() {
-
-	vkInit::SwapChainBundle bundle = vkInit::create_swapchain(
-		device, physicalDevice, surface, width, height
-	);
-	swapchain = bundle.swapchain;
-	swapchainFrames = bundle.frames;
-	swapchainFormat = bundle.format;
-	swapchainExtent = bundle.extent;
-	maxFramesInFlight = static_cast<int>(swapchainFrames.size());
-	choose_color_conversion_function();
-
-	//std::cout << "Format: " << (int)swapchainFormat << std::endl;
-
-	for (vkUtil::SwapChainFrame& frame : swapchainFrames) {
-		frame.logicalDevice = device;
-		frame.physicalDevice = physicalDevice;
-		frame.width = swapchainExtent.width;
-		frame.height = swapchainExtent.height;
-	}
-
-}
-
-void Engine::choose_color_conversion_function() {
-
-	if (swapchainFormat == vk::Format::eR8G8B8A8Unorm) {
-		convert_color = &convert_to_r8g8b8a8_unorm;
-	}
-
-	else if (swapchainFormat == vk::Format::eB8G8R8A8Unorm) {
-		convert_color = &convert_to_b8g8r8a8_unorm;
-	}
-}
-
-void Engine::clear_screen(float r, float g, float b) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	unsigned char* color = convert_color(r, g, b);
-
-	for (int i = 0; i < _frame.width * _frame.height; ++i) {
-		_frame.colorBufferData[4 * i]     = color[0];
-		_frame.colorBufferData[4 * i + 1] = color[1];
-		_frame.colorBufferData[4 * i + 2] = color[2];
-		_frame.colorBufferData[4 * i + 3] = color[3];
-	}
-}
-
-void Engine::clear_screen_avx2(float r, float g, float b) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	unsigned char* color = convert_color(r, g, b);
-
-	__m256 block = _mm256_set1_ps(*(float*)color);
-
-	int pixelCount = _frame.width * _frame.height;
-	int blockCount = pixelCount / 8;
-
-	__m256* blocks = (__m256*) _frame.colorBufferData.data();
-
-	for (int i = 0; i < blockCount; ++i) {
-		blocks[i] = block;
-	}
-	
-	for (int i = 8 * blockCount; i < pixelCount; ++i) {
-		_frame.colorBufferData[4 * i] = color[0];
-		_frame.colorBufferData[4 * i + 1] = color[1];
-		_frame.colorBufferData[4 * i + 2] = color[2];
-		_frame.colorBufferData[4 * i + 3] = color[3];
-	}
-	
-}
-
-void Engine::draw_horizontal_line(float r, float g, float b, int x1, int x2, int y) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	unsigned char* color = convert_color(r, g, b);
-
-	x1 = std::min(_frame.width - 1, std::max(0, x1));
-	x2 = std::min(_frame.width - 1, std::max(0, x2));
-	y = std::min(_frame.height - 1, std::max(0, y));
-
-	for (int x = x1; x < x2; ++x) {
-		int pixel = 4 * (_frame.width * y + x);
-		_frame.colorBufferData[pixel] = color[0];
-		_frame.colorBufferData[pixel + 1] = color[1];
-		_frame.colorBufferData[pixel + 2] = color[2];
-		_frame.colorBufferData[pixel + 3] = color[3];
-	}
-}
-
-void Engine::draw_horizontal_line_avx2(float r, float g, float b, int x1, int x2, int y) {
-
-	if ((x2 - x1) < 16) {
-		draw_horizontal_line(r, g, b, x1, x2, y);
-		return;
-	}
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	unsigned char* color = convert_color(r, g, b);
-
-	x1 = std::min(_frame.width - 1, std::max(0, x1));
-	x2 = std::min(_frame.width - 1, std::max(0, x2));
-	y = std::min(_frame.height - 1, std::max(0, y));
-
-	__m256 block = _mm256_set1_ps(*(float*)color);
-
-	int startPixel = _frame.width * y + x1;
-	int startBlock = (startPixel / 8) + 1;
-	int endPixel = _frame.width * y + x2;
-	int endBlock = (endPixel / 8) - 1;
-
-	__m256* blocks = (__m256*) _frame.colorBufferData.data();
-
-	for (int pixel = startPixel; pixel < startBlock * 8; ++pixel) {
-		_frame.colorBufferData[4 * pixel] = color[0];
-		_frame.colorBufferData[4 * pixel + 1] = color[1];
-		_frame.colorBufferData[4 * pixel + 2] = color[2];
-		_frame.colorBufferData[4 * pixel + 3] = color[3];
-	}
-
-	for (int i = startBlock; i < endBlock; ++i) {
-		blocks[i] = block;
-	}
-
-	for (int pixel = endBlock * 8; pixel < endPixel; ++pixel) {
-		_frame.colorBufferData[4 * pixel] = color[0];
-		_frame.colorBufferData[4 * pixel + 1] = color[1];
-		_frame.colorBufferData[4 * pixel + 2] = color[2];
-		_frame.colorBufferData[4 * pixel + 3] = color[3];
-	}
-}
-
-void Engine::draw_vertical_line(float r, float g, float b, int x, int y1, int y2) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	unsigned char* color = convert_color(r, g, b);
-
-	x = std::min(_frame.width - 1, std::max(0, x));
-	y1 = std::min(_frame.height - 1, std::max(0, y1));
-	y2 = std::min(_frame.height - 1, std::max(0, y2));
-
-	for (int y = y1; y < y2; ++y) {
-		int pixel = 4 * (_frame.width * y + x);
-		_frame.colorBufferData[pixel] = color[0];
-		_frame.colorBufferData[pixel + 1] = color[1];
-		_frame.colorBufferData[pixel + 2] = color[2];
-		_frame.colorBufferData[pixel + 3] = color[3];
-	}
-}
-
-void Engine::draw_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2) {
-
-	if (x1 == x2) {
-		if (y1 < y2) {
-			draw_vertical_line(r, g, b, x1, y1, y2);
-		}
-		else {
-			draw_vertical_line(r, g, b, x1, y2, y1);
-		}
-		return;
-	}
-
-	if (y1 == y2) {
-		if (x1 < x2) {
-			draw_horizontal_line_avx2(r, g, b, x1, x2, y1);
-		}
-		else {
-			draw_horizontal_line_avx2(r, g, b, x2, x1, y1);
-		}
-		return;
-	}
-
-	if (abs(y2 - y1) < abs(x2 - x1)) {
-		if (x1 < x2) {
-			draw_shallow_line_naive(r, g, b, x1, y1, x2, y2);
-		}
-		else {
-			draw_shallow_line_naive(r, g, b, x2, y2, x1, y1);
-		}
-		return;
-	}
-
-	if (y1 < y2) {
-		draw_steep_line_naive(r, g, b, x1, y1, x2, y2);
-	}
-	else {
-		draw_steep_line_naive(r, g, b, x2, y2, x1, y1);
-	}
-}
-
-void Engine::draw_shallow_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	unsigned char* color = convert_color(r, g, b);
-
-	float dydx = (float)(y2 - y1) / (x2 - x1);
-
-	x1 = std::min(_frame.width - 1, std::max(0, x1));
-	x2 = std::min(_frame.width - 1, std::max(0, x2));
-	y1 = std::min(_frame.height - 1, std::max(0, y1));
-	y2 = std::min(_frame.height - 1, std::max(0, y2));
-
-	float y = y1;
-	int screen_y, pixel;
-	for (int x = x1; x < x2; ++x) {
-
-		screen_y = (int)y;
-		pixel = 4 * (_frame.width * screen_y + x);
-		_frame.colorBufferData[pixel] = color[0];
-		_frame.colorBufferData[pixel + 1] = color[1];
-		_frame.colorBufferData[pixel + 2] = color[2];
-		_frame.colorBufferData[pixel + 3] = color[3];
-
-		y += dydx;
-	}
-
-}
-
-void Engine::draw_steep_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	unsigned char* color = convert_color(r, g, b);
-
-	float dxdy = (float)(x2 - x1) / (y2 - y1);
-
-	x1 = std::min(_frame.width - 1, std::max(0, x1));
-	x2 = std::min(_frame.width - 1, std::max(0, x2));
-	y1 = std::min(_frame.height - 1, std::max(0, y1));
-	y2 = std::min(_frame.height - 1, std::max(0, y2));
-
-	float x = x1;
-	int screen_x, pixel;
-	for (int y = y1; y < y2; ++y) {
-
-		screen_x = (int)x;
-		pixel = 4 * (_frame.width * y + screen_x);
-		_frame.colorBufferData[pixel] = color[0];
-		_frame.colorBufferData[pixel + 1] = color[1];
-		_frame.colorBufferData[pixel + 2] = color[2];
-		_frame.colorBufferData[pixel + 3] = color[3];
-
-		x += dxdy;
-	}
-
-}
-
-void Engine::draw_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2) {
-
-	if (x1 == x2) {
-		if (y1 < y2) {
-			draw_vertical_line(r, g, b, x1, y1, y2);
-		}
-		else {
-			draw_vertical_line(r, g, b, x1, y2, y1);
-		}
-		return;
-	}
-
-	if (y1 == y2) {
-		if (x1 < x2) {
-			draw_horizontal_line_avx2(r, g, b, x1, x2, y1);
-		}
-		else {
-			draw_horizontal_line_avx2(r, g, b, x2, x1, y1);
-		}
-		return;
-	}
-
-	if (abs(y2 - y1) < abs(x2 - x1)) {
-		if (x1 < x2) {
-			draw_shallow_line_bresenham(r, g, b, x1, y1, x2, y2);
-		}
-		else {
-			draw_shallow_line_bresenham(r, g, b, x2, y2, x1, y1);
-		}
-		return;
-	}
-
-	if (y1 < y2) {
-		draw_steep_line_bresenham(r, g, b, x1, y1, x2, y2);
-	}
-	else {
-		draw_steep_line_bresenham(r, g, b, x2, y2, x1, y1);
-	}
-}
-
-void Engine::draw_shallow_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	unsigned char* color = convert_color(r, g, b);
-
-	x1 = std::min(_frame.width - 1, std::max(0, x1));
-	x2 = std::min(_frame.width - 1, std::max(0, x2));
-	y1 = std::min(_frame.height - 1, std::max(0, y1));
-	y2 = std::min(_frame.height - 1, std::max(0, y2));
-
-	int dx = x2 - x1;
-	int dy = y2 - y1;
-	int yInc = 1;
-	if (dy < 0) {
-		yInc = -1;
-		dy *= -1;
-	}
-
-	int D = 2 * dy - dx;
-	int dDInc = 2 * (dy - dx);
-	int dDNoInc = 2 * dy;
-
-	int pixel;
-	int y = y1;
-	for (int x = x1; x < x2; ++x) {
-
-		pixel = 4 * (_frame.width * y + x);
-		_frame.colorBufferData[pixel] = color[0];
-		_frame.colorBufferData[pixel + 1] = color[1];
-		_frame.colorBufferData[pixel + 2] = color[2];
-		_frame.colorBufferData[pixel + 3] = color[3];
-
-		if (D > 0) {
-			y += yInc;
-			D += dDInc;
-		}
-		else {
-			D += dDNoInc;
-		}
-	}
-
-}
-
-void Engine::draw_steep_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	unsigned char* color = convert_color(r, g, b);
-
-	x1 = std::min(_frame.width - 1, std::max(0, x1));
-	x2 = std::min(_frame.width - 1, std::max(0, x2));
-	y1 = std::min(_frame.height - 1, std::max(0, y1));
-	y2 = std::min(_frame.height - 1, std::max(0, y2));
-
-	int dx = x2 - x1;
-	int dy = y2 - y1;
-	int xInc = 1;
-	if (dx < 0) {
-		xInc = -1;
-		dx *= -1;
-	}
-
-	int D = 2 * dx - dy;
-	int dDInc = 2 * (dx - dy);
-	int dDNoInc = 2 * dx;
-
-	int pixel;
-	int x = x1;
-	for (int y = y1; y < y2; ++y) {
-
-		pixel = 4 * (_frame.width * y + x);
-		_frame.colorBufferData[pixel] = color[0];
-		_frame.colorBufferData[pixel + 1] = color[1];
-		_frame.colorBufferData[pixel + 2] = color[2];
-		_frame.colorBufferData[pixel + 3] = color[3];
-
-		if (D > 0) {
-			x += xInc;
-			D += dDInc;
-		}
-		else {
-			D += dDNoInc;
-		}
-	}
-
-}
-
-void Engine::draw_polygon_flat(float r, float g, float b, edgeTable polygon) {
-
-	int x_start[480];
-	int x_end[480];
-	int y_min = 480;
-	int y_max = 0;
-
-	for (int i = 0; i < polygon.vertexCount; ++i) {
-
-		vec4 vertex = polygon.vertices[i];
-
-		if (vertex.data[1] < y_min) {
-			y_min = std::max(0, (int)vertex.data[1]);
-		}
-
-		if (vertex.data[1] > y_max) {
-			y_max = std::min(479, (int)vertex.data[1]);
-		}
-	}
-
-	for (int y = y_min; y <= y_max; ++y) {
-		x_start[y] = 640;
-		x_end[y] = 0;
-	}
-
-	for (int j = 0; j < polygon.vertexCount; ++j) {
-		int x1 = (int)polygon.vertices[j].data[0];
-		int y1 = (int)polygon.vertices[j].data[1];
-		int x2 = (int)polygon.vertices[(j + 1) % polygon.vertexCount].data[0];
-		int y2 = (int)polygon.vertices[(j + 1) % polygon.vertexCount].data[1];
-
-		if (abs(x2 - x1) < abs(y2 - y1)) {
-			if (y1 < y2) {
-				trace_steep_edge(x1, y1, x2, y2, x_start, x_end);
-			}
-			else {
-				trace_steep_edge(x2, y2, x1, y1, x_start, x_end);
-			}
-		}
-		else {
-			if (x1 < x2) {
-				trace_shallow_edge(x1, y1, x2, y2, x_start, x_end);
-			}
-			else {
-				trace_shallow_edge(x2, y2, x1, y1, x_start, x_end);
-			}
-		}
-	}
-
-	for (int y = y_min; y <= y_max; ++y) {
-		draw_horizontal_line_avx2(r, g, b, x_start[y], x_end[y], y);
-	}
-}
-
-void Engine:: trace_shallow_edge(int x1, int y1, int x2, int y2, int* x_start, int* x_end) {
-
-	int dx = x2 - x1;
-	int dy = y2 - y1;
-	int yInc = 1;
-	if (dy < 0) {
-		yInc = -1;
-		dy *= -1;
-	}
-
-	int D = 2 * dy - dx;
-	int dDInc = 2 * (dy - dx);
-	int dDNoInc = 2 * dy;
-
-	int pixel;
-	int y = y1;
-	for (int x = x1; x <= x2; ++x) {
-
-		if (x < x_start[y] && y > 0 && y < 479) {
-			x_start[y] = x;
-		}
-
-		if (x > x_end[y] && y > 0 && y < 479) {
-			x_end[y] = x;
-		}
-
-		if (D > 0) {
-			y += yInc;
-			D += dDInc;
-		}
-		else {
-			D += dDNoInc;
-		}
-	}
-}
-
-void Engine::trace_steep_edge(int x1, int y1, int x2, int y2, int* x_start, int* x_end) {
-
-	int dx = x2 - x1;
-	int dy = y2 - y1;
-	int xInc = 1;
-	if (dx < 0) {
-		xInc = -1;
-		dx *= -1;
-	}
-
-	int D = 2 * dx - dy;
-	int dDInc = 2 * (dx - dy);
-	int dDNoInc = 2 * dx;
-
-	int pixel;
-	int x = x1;
-	for (int y = y1; y < y2; ++y) {
-
-		if (x < x_start[y] && y > 0 && y < 479) {
-			x_start[y] = x;
-		}
-
-		if (x > x_end[y] && y > 0 && y < 479) {
-			x_end[y] = x;
-		}
-
-		if (D > 0) {
-			x += xInc;
-			D += dDInc;
-		}
-		else {
-			D += dDNoInc;
-		}
-	}
-}
-
-void Engine::draw_polygon_blended(edgeTable polygon) {
-
-	vertex* vertex_start = (vertex*)malloc(480 * sizeof(vertex));
-	vertex* vertex_end = (vertex*)malloc(480 * sizeof(vertex));
-	int y_min = 480;
-	int y_max = 0;
-
-	for (int i = 0; i < polygon.vertexCount; ++i) {
-
-		vec4 vertex = polygon.vertices[i];
-
-		if (vertex.data[1] < y_min) {
-			y_min = std::max(0, (int)vertex.data[1]);
-		}
-
-		if (vertex.data[1] > y_max) {
-			y_max = std::min(479, (int)vertex.data[1]);
-		}
-	}
-
-	for (int y = y_min; y <= y_max; ++y) {
-		vertex_start[y].x = 640;
-		vertex_end[y].x = 0;
-	}
-
-	for (int j = 0; j < polygon.vertexCount; ++j) {
-
-		vertex v1;
-		v1.x = (int)polygon.vertices[j].data[0];
-		v1.y = (int)polygon.vertices[j].data[1];
-		v1.attributes = polygon.payloads[j];
-
-		vertex v2;
-		int k = (j + 1) % polygon.vertexCount;
-		v2.x = (int)polygon.vertices[k].data[0];
-		v2.y = (int)polygon.vertices[k].data[1];
-		v2.attributes = polygon.payloads[k];
-
-		if (abs(v2.x - v1.x) < abs(v2.y - v1.y)) {
-			if (v1.y < v2.y) {
-				interpolate_steep_edge(v1, v2, vertex_start, vertex_end);
-			}
-			else {
-				interpolate_steep_edge(v2, v1, vertex_start, vertex_end);
-			}
-		}
-		else {
-			if (v1.x < v2.x) {
-				interpolate_shallow_edge(v1, v2, vertex_start, vertex_end);
-			}
-			else {
-				interpolate_shallow_edge(v2, v1, vertex_start, vertex_end);
-			}
-		}
-	}
-
-	for (int y = y_min; y <= y_max; ++y) {
-		draw_horizontal_line_blended(vertex_start[y], vertex_end[y], y);
-	}
-
-	free(vertex_start);
-	free(vertex_end);
-}
-
-void Engine::interpolate_shallow_edge(vertex v1, vertex v2, vertex* vertex_start, vertex* vertex_end) {
-
-	int dx = v2.x - v1.x;
-	int dy = v2.y - v1.y;
-	int yInc = 1;
-	if (dy < 0) {
-		yInc = -1;
-		dy *= -1;
-	}
-
-	int D = 2 * dy - dx;
-	int dDInc = 2 * (dy - dx);
-	int dDNoInc = 2 * dy;
-
-	__m256 dPdx = _mm256_div_ps(
-		_mm256_sub_ps(v2.attributes.lump, v1.attributes.lump),
-		_mm256_set1_ps(dx)
-	);
-	vertex frag = v1;
-	int y = v1.y;
-	for (int x = v1.x; x <= v2.x; ++x) {
-
-		if (x < vertex_start[y].x && y > 0 && y < 479) {
-			vertex_start[y].x = x;
-			vertex_start[y].attributes = frag.attributes;
-		}
-
-		if (x > vertex_end[y].x && y > 0 && y < 479) {
-			vertex_end[y].x = x;
-			vertex_end[y].attributes = frag.attributes;
-		}
-
-		if (D > 0) {
-			y += yInc;
-			D += dDInc;
-		}
-		else {
-			D += dDNoInc;
-		}
-
-		frag.attributes.lump = _mm256_add_ps(frag.attributes.lump, dPdx);
-	}
-
-}
-
-void Engine::interpolate_steep_edge(vertex v1, vertex v2, vertex* vertex_start, vertex* vertex_end) {
-
-	int dx = v2.x - v1.x;
-	int dy = v2.y - v1.y;
-	int xInc = 1;
-	if (dx < 0) {
-		xInc = -1;
-		dx *= -1;
-	}
-
-	int D = 2 * dx - dy;
-	int dDInc = 2 * (dx - dy);
-	int dDNoInc = 2 * dx;
-
-	__m256 dPdy = _mm256_div_ps(
-		_mm256_sub_ps(v2.attributes.lump, v1.attributes.lump),
-		_mm256_set1_ps(dy)
-	);
-	vertex frag = v1;
-	int x = v1.x;
-	for (int y = v1.y; y <= v2.y; ++y) {
-
-		if (x < vertex_start[y].x && y > 0 && y < 479) {
-			vertex_start[y].x = x;
-			vertex_start[y].attributes = frag.attributes;
-		}
-
-		if (x > vertex_end[y].x && y > 0 && y < 479) {
-			vertex_end[y].x = x;
-			vertex_end[y].attributes = frag.attributes;
-		}
-
-		if (D > 0) {
-			x += xInc;
-			D += dDInc;
-		}
-		else {
-			D += dDNoInc;
-		}
-
-		frag.attributes.lump = _mm256_add_ps(frag.attributes.lump, dPdy);
-	}
-}
-
-void Engine::draw_horizontal_line_blended(vertex v1, vertex v2, int y) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	int x1 = std::min(_frame.width - 1, std::max(0, v1.x));
-	int x2 = std::min(_frame.width - 1, std::max(0, v2.x));
-	y = std::min(_frame.height - 1, std::max(0, y));
-	payload fragment = v1.attributes;
-	__m256 dPdx = _mm256_div_ps(
-		_mm256_sub_ps(v2.attributes.lump, v1.attributes.lump),
-		_mm256_set1_ps(x2 - x1)
-	);
-
-	for (int x = x1; x < x2; ++x) {
-
-		unsigned char* color = convert_color(fragment.data[0], fragment.data[1], fragment.data[2]);
-		int pixel = 4 * (_frame.width * y + x);
-		_frame.colorBufferData[pixel] = color[0];
-		_frame.colorBufferData[pixel + 1] = color[1];
-		_frame.colorBufferData[pixel + 2] = color[2];
-		_frame.colorBufferData[pixel + 3] = color[3];
-
-		fragment.lump = _mm256_add_ps(fragment.lump, dPdx);
-	}
-}
-
-texture Engine::convert_texture(stbi_uc* textureData, int width, int height) {
-
-	texture tex;
-	tex.width = width;
-	tex.height = height;
-	tex.r = (float*)malloc(width * height * sizeof(float));
-	tex.g = (float*)malloc(width * height * sizeof(float));
-	tex.b = (float*)malloc(width * height * sizeof(float));
-
-	for (int y = 0; y < height; ++y) {
-		for (int x = 0; x < width; ++x) {
-			tex.r[width * y + x] = (float)textureData[4 * (width * y + x)] / 255;
-			tex.g[width * y + x] = (float)textureData[4 * (width * y + x) + 1] / 255;
-			tex.b[width * y + x] = (float)textureData[4 * (width * y + x) + 2] / 255;
-		}
-	}
-
-	return tex;
-}
-
-void Engine::draw_polygon_textured(edgeTable& polygon, texture& tex) {
-
-	vertex* vertex_start = (vertex*)malloc(480 * sizeof(vertex));
-	vertex* vertex_end = (vertex*)malloc(480 * sizeof(vertex));
-	int y_min = 480;
-	int y_max = 0;
-
-	for (int i = 0; i < polygon.vertexCount; ++i) {
-
-		vec4 vertex = polygon.vertices[i];
-
-		if (vertex.data[1] < y_min) {
-			y_min = std::max(0, (int)vertex.data[1]);
-		}
-
-		if (vertex.data[1] > y_max) {
-			y_max = std::min(479, (int)vertex.data[1]);
-		}
-	}
-
-	for (int y = y_min; y <= y_max; ++y) {
-		vertex_start[y].x = 640;
-		vertex_end[y].x = 0;
-	}
-
-	for (int j = 0; j < polygon.vertexCount; ++j) {
-
-		vertex v1;
-		v1.x = (int)polygon.vertices[j].data[0];
-		v1.y = (int)polygon.vertices[j].data[1];
-		v1.attributes = polygon.payloads[j];
-
-		vertex v2;
-		int k = (j + 1) % polygon.vertexCount;
-		v2.x = (int)polygon.vertices[k].data[0];
-		v2.y = (int)polygon.vertices[k].data[1];
-		v2.attributes = polygon.payloads[k];
-
-		if (abs(v2.x - v1.x) < abs(v2.y - v1.y)) {
-			if (v1.y < v2.y) {
-				interpolate_steep_edge(v1, v2, vertex_start, vertex_end);
-			}
-			else {
-				interpolate_steep_edge(v2, v1, vertex_start, vertex_end);
-			}
-		}
-		else {
-			if (v1.x < v2.x) {
-				interpolate_shallow_edge(v1, v2, vertex_start, vertex_end);
-			}
-			else {
-				interpolate_shallow_edge(v2, v1, vertex_start, vertex_end);
-			}
-		}
-	}
-
-	for (int y = y_min; y <= y_max; ++y) {
-		draw_horizontal_line_textured(vertex_start[y], vertex_end[y], y, tex);
-	}
-
-	free(vertex_start);
-	free(vertex_end);
-}
-
-void Engine::draw_horizontal_line_textured(vertex v1, vertex v2, int y, texture& tex) {
-
-	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
-
-	int x1 = std::min(_frame.width - 1, std::max(0, v1.x));
-	int x2 = std::min(_frame.width - 1, std::max(0, v2.x));
-	y = std::min(_frame.height - 1, std::max(0, y));
-	payload fragment = v1.attributes;
-	__m256 dPdx = _mm256_div_ps(
-		_mm256_sub_ps(v2.attributes.lump, v1.attributes.lump),
-		_mm256_set1_ps(x2 - x1)
-	);
-
-	for (int x = x1; x < x2; ++x) {
-
-		int u_left = std::min(tex.width - 1, std::max(0, (int)(tex.width * fragment.data[3])));
-		int u_right = std::min(tex.width - 1, std::max(0, u_left + 1));
-		float frac_u = tex.width * fragment.data[3] - u_left;
-		float left = 1.0f - frac_u;
-		float right = frac_u;
-
-		int v_top = std::min(tex.height - 1, std::max(0, (int)(tex.height * fragment.data[4])));
-		int v_bottom = std::min(tex.height - 1, std::max(0, v_top + 1));
-		float frac_v = tex.height * fragment.data[4] - v_top;
-		float top = 1.0f - frac_v;
-		float bottom = frac_v;
-
-		float r = fragment.data[0] * (
-			top * (
-				left * tex.r[v_top * tex.width + u_left] + right * tex.r[v_top * tex.width + u_right]
-				)
-			+ bottom * (
-				left * tex.r[v_bottom * tex.width + u_left] + right * tex.r[v_bottom * tex.width + u_right]
-				)
-		);
-
-		float g = fragment.data[1] * (
-			top * (
-				left * tex.g[v_top * tex.width + u_left] + right * tex.g[v_top * tex.width + u_right]
-				)
-			+ bottom * (
-				left * tex.g[v_bottom * tex.width + u_left] + right * tex.g[v_bottom * tex.width + u_right]
-				)
-			);
-
-		float b = fragment.data[2] * (
-			top * (
-				left * tex.b[v_top * tex.width + u_left] + right * tex.b[v_top * tex.width + u_right]
-				)
-			+ bottom * (
-				left * tex.b[v_bottom * tex.width + u_left] + right * tex.b[v_bottom * tex.width + u_right]
-				)
-			);
-
-		unsigned char* color = convert_color(r, g, b);
-		int pixel = 4 * (_frame.width * y + x);
-		_frame.colorBufferData[pixel] = color[0];
-		_frame.colorBufferData[pixel + 1] = color[1];
-		_frame.colorBufferData[pixel + 2] = color[2];
-		_frame.colorBufferData[pixel + 3] = color[3];
-
-		fragment.lump = _mm256_add_ps(fragment.lump, dPdx);
-	}
-}
-
-/**
-* The swapchain must be recreated upon resize or minimization, among other cases
-*/
-void Engine::recreate_swapchain() {
-
-	width = 0;
-	height = 0;
-	while (width == 0 || height == 0) {
-		glfwGetFramebufferSize(window, &width, &height);
-		glfwWaitEvents();
-	}
-
-	device.waitIdle();
-
-	cleanup_swapchain();
-	make_swapchain();
-	make_frame_resources();
-	vkInit::commandBufferInputChunk commandBufferInput = { device, commandPool, swapchainFrames };
-	vkInit::make_frame_command_buffers(commandBufferInput);
-
-}
-
-void Engine::finalize_setup() {
-
-	commandPool = vkInit::make_command_pool(device, physicalDevice, surface);
-
-	vkInit::commandBufferInputChunk commandBufferInput = { device, commandPool, swapchainFrames };
-	mainCommandBuffer = vkInit::make_command_buffer(commandBufferInput);
-	vkInit::make_frame_command_buffers(commandBufferInput);
-
-	make_frame_resources();
-
-}
-
-void Engine::make_frame_resources() {
-
-	for (vkUtil::SwapChainFrame& frame : swapchainFrames) {
-
-		frame.imageAvailable = vkInit::make_semaphore(device);
-		frame.renderFinished = vkInit::make_semaphore(device);
-		frame.inFlight = vkInit::make_fence(device);
-
-		frame.setup();
-	}
-
-}
-
-void Engine::flush_frame(uint32_t imageIndex, uint32_t frameNumber) {
-
-	vk::CommandBuffer& commandBuffer = swapchainFrames[frameNumber].commandBuffer;
-
-	vk::CommandBufferBeginInfo beginInfo = {};
-
-	try {
-		commandBuffer.begin(beginInfo);
-	}
-	catch (vk::SystemError err) {
-		vkLogging::Logger::get_logger()->print("Failed to begin recording command buffer!");
-	}
-
-	swapchainFrames[imageIndex].flush();
-
-	try {
-		commandBuffer.end();
-	}
-	catch (vk::SystemError err) {
-		
-		vkLogging::Logger::get_logger()->print("failed to record command buffer!");
-	}
-}
-
-void Engine::render() {
-
-	device.waitForFences(1, &(swapchainFrames[frameNumber].inFlight), VK_TRUE, UINT64_MAX);
-	device.resetFences(1, &(swapchainFrames[frameNumber].inFlight));
-
-	uint32_t imageIndex;
-	try {
-		vk::ResultValue acquire = device.acquireNextImageKHR(
-			swapchain, UINT64_MAX, 
-			swapchainFrames[frameNumber].imageAvailable, nullptr
-		);
-		imageIndex = acquire.value;
-	}
-	catch (vk::OutOfDateKHRError error) {
-		std::cout << "Recreate" << std::endl;
-		recreate_swapchain();
-		return;
-	}
-	catch (vk::IncompatibleDisplayKHRError error) {
-		std::cout << "Recreate" << std::endl;
-		recreate_swapchain();
-		return;
-	}
-	catch (vk::SystemError error) {
-		std::cout << "Failed to acquire swapchain image!" << std::endl;
-	}
-
-	vk::CommandBuffer& commandBuffer = swapchainFrames[frameNumber].commandBuffer;
-
-	commandBuffer.reset();
-
-	flush_frame(imageIndex, frameNumber);
-
-	vk::SubmitInfo submitInfo = {};
-
-	vk::Semaphore waitSemaphores[] = { swapchainFrames[frameNumber].imageAvailable };
-	vk::PipelineStageFlags waitStages[] = { vk::PipelineStageFlagBits::eColorAttachmentOutput };
-	submitInfo.waitSemaphoreCount = 1;
-	submitInfo.pWaitSemaphores = waitSemaphores;
-	submitInfo.pWaitDstStageMask = waitStages;
-
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &commandBuffer;
-
-	vk::Semaphore signalSemaphores[] = { swapchainFrames[frameNumber].renderFinished };
-	submitInfo.signalSemaphoreCount = 1;
-	submitInfo.pSignalSemaphores = signalSemaphores;
-
-	try {
-		graphicsQueue.submit(submitInfo, swapchainFrames[frameNumber].inFlight);
-	}
-	catch (vk::SystemError err) {
-		vkLogging::Logger::get_logger()->print("failed to submit draw command buffer!");
-	}
-
-	vk::PresentInfoKHR presentInfo = {};
-	presentInfo.waitSemaphoreCount = 1;
-	presentInfo.pWaitSemaphores = signalSemaphores;
-
-	vk::SwapchainKHR swapChains[] = { swapchain };
-	presentInfo.swapchainCount = 1;
-	presentInfo.pSwapchains = swapChains;
-
-	presentInfo.pImageIndices = &imageIndex;
-
-	vk::Result present;
-
-	try {
-		present = presentQueue.presentKHR(presentInfo);
-	}
-	catch (vk::OutOfDateKHRError error) {
-		present = vk::Result::eErrorOutOfDateKHR;
-	}
-
-	if (present == vk::Result::eErrorOutOfDateKHR || present == vk::Result::eSuboptimalKHR) {
-		std::cout << "Recreate" << std::endl;
-		recreate_swapchain();
-		return;
-	}
-
-	frameNumber = (frameNumber + 1) % maxFramesInFlight;
-
-}
-
-/**
-* Free the memory associated with the swapchain objects
-*/
-void Engine::cleanup_swapchain() {
-
-	for (vkUtil::SwapChainFrame& frame : swapchainFrames) {
-		frame.destroy();
-	}
-	device.destroySwapchainKHR(swapchain);
-
-}
-
-Engine::~Engine() {
-
-	device.waitIdle();
-
-	vkLogging::Logger::get_logger()->print("Goodbye see you!");
-
-	device.destroyCommandPool(commandPool);
-
-	cleanup_swapchain();
-
-	device.destroy();
-
-	instance.destroySurfaceKHR(surface);
-	if (vkLogging::Logger::get_logger()->get_debug_mode()) {
-		instance.destroyDebugUtilsMessengerEXT(debugMessenger, nullptr, dldi);
-	}
-	/*
-	* from vulkan_funcs.hpp:
-	* 
-	* void Instance::destroy( Optional<const VULKAN_HPP_NAMESPACE::AllocationCallbacks> allocator = nullptr,
-                                            Dispatch const & d = ::vk::getDispatchLoaderStatic())
-	*/
-	instance.destroy();
-
-	//terminate glfw
-	glfwTerminate();
+#include "engine.h"
+#include "vkInit/instance.h"
+#include "vkInit/device.h"
+#include "vkInit/swapchain.h"
+#include "vkInit/commands.h"
+#include "vkInit/sync.h"
+#include "graphics_library.h"
+#include "../control/profiler.h"
+#include <limits>
+
+/**
+* Construct an engine presenting to a window.
+*
+* @param policy	whether presentation favours latency, throughput or pacing
+*/
+Engine::Engine(int width, int height, GLFWwindow* window, presentPolicy policy) {
+
+	this->width = width;
+	this->height = height;
+	this->window = window;
+	this->policy = policy;
+
+	vkLogging::Logger::get_logger()->print("Making a graphics engine...");
+
+	make_instance();
+
+	make_device();
+
+	finalize_setup();
+
+}
+
+/**
+* Construct a headless engine, finished frames are handed to the given
+* target rather than presented through a swapchain.
+*/
+Engine::Engine(int width, int height, renderTarget::RenderTarget* target) {
+
+	this->width = width;
+	this->height = height;
+	this->window = nullptr;
+	this->target = target;
+
+	vkLogging::Logger::get_logger()->print("Making a headless graphics engine...");
+
+	make_headless_frames();
+
+}
+
+void Engine::make_headless_frames() {
+
+	swapchainFormat = target->get_format();
+	swapchainExtent = vk::Extent2D(width, height);
+	choose_color_conversion_function();
+
+	//a single frame, there's nothing to wait on between frames
+	swapchainFrames.resize(1);
+	maxFramesInFlight = 1;
+	frameNumber = 0;
+
+	for (vkUtil::SwapChainFrame& frame : swapchainFrames) {
+		frame.width = width;
+		frame.height = height;
+		frame.setup_color_buffer();
+		frame.setup_depth_buffer();
+	}
+
+	fit_to_extent();
+}
+
+void Engine::make_instance() {
+
+	instance = vkInit::make_instance("ID Tech 12");
+	dldi = vk::DispatchLoaderDynamic(instance, vkGetInstanceProcAddr);
+	if (vkLogging::Logger::get_logger()->get_debug_mode()) {
+		debugMessenger = vkLogging::make_debug_messenger(instance, dldi);
+	}
+	VkSurfaceKHR c_style_surface;
+	if (glfwCreateWindowSurface(instance, window, nullptr, &c_style_surface) != VK_SUCCESS) {
+		vkLogging::Logger::get_logger()->print("Failed to abstract glfw surface for Vulkan.");
+	}
+	else {
+		vkLogging::Logger::get_logger()->print(
+			"Successfully abstracted glfw surface for Vulkan.");
+	}
+	//copy constructor converts to hpp convention
+	surface = c_style_surface;
+}
+
+void Engine::make_device() {
+
+	physicalDevice = vkInit::choose_physical_device(instance);
+	device = vkInit::create_logical_device(physicalDevice, surface);
+	std::array<vk::Queue,2> queues = vkInit::get_queues(physicalDevice, device, surface);
+	graphicsQueue = queues[0];
+	presentQueue = queues[1];
+	make_swapchain();
+	frameNumber = 0;
+}
+
+/**
+* Make a swapchain
+*/
+void Engine::make_swapchain() {
+
+	vkInit::SwapChainBundle bundle = vkInit::create_swapchain(
+		device, physicalDevice, surface, width, height, policy
+	);
+	swapchain = bundle.swapchain;
+	swapchainFrames = bundle.frames;
+	swapchainFormat = bundle.format;
+	swapchainExtent = bundle.extent;
+	maxFramesInFlight = static_cast<int>(swapchainFrames.size());
+	choose_color_conversion_function();
+
+	//std::cout << "Format: " << (int)swapchainFormat << std::endl;
+
+	for (vkUtil::SwapChainFrame& frame : swapchainFrames) {
+		frame.logicalDevice = device;
+		frame.physicalDevice = physicalDevice;
+		frame.width = swapchainExtent.width;
+		frame.height = swapchainExtent.height;
+	}
+
+	fit_to_extent();
+}
+
+/**
+* Size everything that depends on the resolution to the current swapchain extent:
+* the scanline tables, one entry per row, the viewport transform and the
+* overdraw counts, if they're kept.
+*/
+void Engine::fit_to_extent() {
+
+	scanlineStartX.resize(swapchainExtent.height);
+	scanlineEndX.resize(swapchainExtent.height);
+	scanlineStart.resize(swapchainExtent.height);
+	scanlineEnd.resize(swapchainExtent.height);
+
+	viewport = linalgMakeViewportTransform(swapchainExtent.width, swapchainExtent.height);
+
+	if (overdrawCounting) {
+		covered.assign(swapchainExtent.width * swapchainExtent.height, 0);
+	}
+}
+
+/**
+* Pick the conversion for the swapchain's format, and the per pixel loops
+* specialized for it, so shading never goes through a pointer per pixel.
+*/
+void Engine::choose_color_conversion_function() {
+
+	if (swapchainFormat == vk::Format::eR8G8B8A8Unorm) {
+		convert_color = &convert_to_r8g8b8a8_unorm;
+		choose_span_loops<vk::Format::eR8G8B8A8Unorm>();
+	}
+
+	else if (swapchainFormat == vk::Format::eB8G8R8A8Unorm) {
+		convert_color = &convert_to_b8g8r8a8_unorm;
+		choose_span_loops<vk::Format::eB8G8R8A8Unorm>();
+	}
+}
+
+template<vk::Format format>
+void Engine::choose_span_loops() {
+
+	blendedSpan = &Engine::shade_blended_span<format>;
+	texturedSpan = &Engine::shade_textured_span<format>;
+	halfspaceBlocks = &Engine::shade_halfspace<format>;
+}
+
+void Engine::clear_screen(float r, float g, float b) {
+
+	PROFILE_SCOPE(clear);
+
+	//anything still waiting in the bins would be painted over anyway
+	bins.clear();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	unsigned char* color = convert_color(r, g, b);
+	mark_cleared(color);
+
+	for (int i = 0; i < _frame.width * _frame.height; ++i) {
+		_frame.colorBufferData[4 * i]     = color[0];
+		_frame.colorBufferData[4 * i + 1] = color[1];
+		_frame.colorBufferData[4 * i + 2] = color[2];
+		_frame.colorBufferData[4 * i + 3] = color[3];
+	}
+
+	if (depthTest) {
+		std::fill(_frame.depthBufferData.begin(), _frame.depthBufferData.end(), 1.0f);
+		hiZ.clear(_frame.width, _frame.height);
+		rejectedFragments = 0;
+		occludedPolygons = 0;
+	}
+
+	if (overdrawCounting) {
+		std::fill(covered.begin(), covered.end(), 0);
+		overdrawnFragments = 0;
+	}
+}
+
+void Engine::clear_screen_avx2(float r, float g, float b) {
+
+	PROFILE_SCOPE(clear);
+
+	//anything still waiting in the bins would be painted over anyway
+	bins.clear();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	unsigned char* color = convert_color(r, g, b);
+	mark_cleared(color);
+
+	__m256 block = _mm256_set1_ps(*(float*)color);
+
+	int pixelCount = _frame.width * _frame.height;
+	int blockCount = pixelCount / 8;
+
+	//the color buffer is 64 byte aligned, so whole blocks can use aligned stores
+	float* blocks = (float*) _frame.colorBufferData;
+
+	if (depthTest) {
+		//8 pixels of color and 8 of depth per pass, so both buffers are only walked once
+		float* depth = _frame.depthBufferData.data();
+		__m256 farPlane = _mm256_set1_ps(1.0f);
+		for (int i = 0; i < blockCount; ++i) {
+			_mm256_store_ps(blocks + 8 * i, block);
+			_mm256_storeu_ps(depth + 8 * i, farPlane);
+		}
+		for (int i = 8 * blockCount; i < pixelCount; ++i) {
+			depth[i] = 1.0f;
+		}
+		hiZ.clear(_frame.width, _frame.height);
+		rejectedFragments = 0;
+		occludedPolygons = 0;
+	}
+	else {
+		for (int i = 0; i < blockCount; ++i) {
+			_mm256_store_ps(blocks + 8 * i, block);
+		}
+	}
+	
+	for (int i = 8 * blockCount; i < pixelCount; ++i) {
+		_frame.colorBufferData[4 * i] = color[0];
+		_frame.colorBufferData[4 * i + 1] = color[1];
+		_frame.colorBufferData[4 * i + 2] = color[2];
+		_frame.colorBufferData[4 * i + 3] = color[3];
+	}
+
+	if (overdrawCounting) {
+		std::fill(covered.begin(), covered.end(), 0);
+		overdrawnFragments = 0;
+	}
+}
+
+void Engine::draw_horizontal_line(float r, float g, float b, int x1, int x2, int y) {
+
+	//binned polygons drawn before this have to land underneath it
+	flush_bins();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	unsigned char* color = convert_color(r, g, b);
+
+	x1 = std::min(_frame.width - 1, std::max(0, x1));
+	x2 = std::min(_frame.width, std::max(0, x2));
+	y = std::min(_frame.height - 1, std::max(0, y));
+	mark_dirty(x1, y, x2, y);
+
+	for (int x = x1; x < x2; ++x) {
+		int pixel = 4 * (_frame.width * y + x);
+		_frame.colorBufferData[pixel] = color[0];
+		_frame.colorBufferData[pixel + 1] = color[1];
+		_frame.colorBufferData[pixel + 2] = color[2];
+		_frame.colorBufferData[pixel + 3] = color[3];
+	}
+}
+
+void Engine::draw_horizontal_line_avx2(float r, float g, float b, int x1, int x2, int y) {
+
+	flush_bins();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	//clamped first, a long span may only have a few pixels on screen
+	x1 = std::min(_frame.width - 1, std::max(0, x1));
+	x2 = std::min(_frame.width, std::max(0, x2));
+	y = std::min(_frame.height - 1, std::max(0, y));
+
+	if ((x2 - x1) < 16) {
+		draw_horizontal_line(r, g, b, x1, x2, y);
+		return;
+	}
+
+	unsigned char* color = convert_color(r, g, b);
+	mark_dirty(x1, y, x2, y);
+
+	__m256 block = _mm256_set1_ps(*(float*)color);
+
+	int startPixel = _frame.width * y + x1;
+	int startBlock = (startPixel / 8) + 1;
+	int endPixel = _frame.width * y + x2;
+	int endBlock = (endPixel / 8) - 1;
+
+	//the color buffer is 64 byte aligned, so whole blocks can use aligned stores
+	float* blocks = (float*) _frame.colorBufferData;
+
+	for (int pixel = startPixel; pixel < startBlock * 8; ++pixel) {
+		_frame.colorBufferData[4 * pixel] = color[0];
+		_frame.colorBufferData[4 * pixel + 1] = color[1];
+		_frame.colorBufferData[4 * pixel + 2] = color[2];
+		_frame.colorBufferData[4 * pixel + 3] = color[3];
+	}
+
+	for (int i = startBlock; i < endBlock; ++i) {
+		_mm256_store_ps(blocks + 8 * i, block);
+	}
+
+	for (int pixel = endBlock * 8; pixel < endPixel; ++pixel) {
+		_frame.colorBufferData[4 * pixel] = color[0];
+		_frame.colorBufferData[4 * pixel + 1] = color[1];
+		_frame.colorBufferData[4 * pixel + 2] = color[2];
+		_frame.colorBufferData[4 * pixel + 3] = color[3];
+	}
+}
+
+void Engine::draw_vertical_line(float r, float g, float b, int x, int y1, int y2) {
+
+	flush_bins();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	unsigned char* color = convert_color(r, g, b);
+
+	x = std::min(_frame.width - 1, std::max(0, x));
+	y1 = std::min(_frame.height - 1, std::max(0, y1));
+	y2 = std::min(_frame.height - 1, std::max(0, y2));
+	mark_dirty(x, y1, x, y2);
+
+	for (int y = y1; y < y2; ++y) {
+		int pixel = 4 * (_frame.width * y + x);
+		_frame.colorBufferData[pixel] = color[0];
+		_frame.colorBufferData[pixel + 1] = color[1];
+		_frame.colorBufferData[pixel + 2] = color[2];
+		_frame.colorBufferData[pixel + 3] = color[3];
+	}
+}
+
+void Engine::draw_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2) {
+
+	if (x1 == x2) {
+		if (y1 < y2) {
+			draw_vertical_line(r, g, b, x1, y1, y2);
+		}
+		else {
+			draw_vertical_line(r, g, b, x1, y2, y1);
+		}
+		return;
+	}
+
+	if (y1 == y2) {
+		if (x1 < x2) {
+			draw_horizontal_line_avx2(r, g, b, x1, x2, y1);
+		}
+		else {
+			draw_horizontal_line_avx2(r, g, b, x2, x1, y1);
+		}
+		return;
+	}
+
+	if (abs(y2 - y1) < abs(x2 - x1)) {
+		if (x1 < x2) {
+			draw_shallow_line_naive(r, g, b, x1, y1, x2, y2);
+		}
+		else {
+			draw_shallow_line_naive(r, g, b, x2, y2, x1, y1);
+		}
+		return;
+	}
+
+	if (y1 < y2) {
+		draw_steep_line_naive(r, g, b, x1, y1, x2, y2);
+	}
+	else {
+		draw_steep_line_naive(r, g, b, x2, y2, x1, y1);
+	}
+}
+
+void Engine::draw_shallow_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2) {
+
+	flush_bins();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	unsigned char* color = convert_color(r, g, b);
+
+	float dydx = (float)(y2 - y1) / (x2 - x1);
+
+	x1 = std::min(_frame.width - 1, std::max(0, x1));
+	x2 = std::min(_frame.width - 1, std::max(0, x2));
+	y1 = std::min(_frame.height - 1, std::max(0, y1));
+	y2 = std::min(_frame.height - 1, std::max(0, y2));
+	mark_dirty(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2));
+
+	float y = y1;
+	int screen_y, pixel;
+	for (int x = x1; x < x2; ++x) {
+
+		screen_y = (int)y;
+		pixel = 4 * (_frame.width * screen_y + x);
+		_frame.colorBufferData[pixel] = color[0];
+		_frame.colorBufferData[pixel + 1] = color[1];
+		_frame.colorBufferData[pixel + 2] = color[2];
+		_frame.colorBufferData[pixel + 3] = color[3];
+
+		y += dydx;
+	}
+
+}
+
+void Engine::draw_steep_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2) {
+
+	flush_bins();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	unsigned char* color = convert_color(r, g, b);
+
+	float dxdy = (float)(x2 - x1) / (y2 - y1);
+
+	x1 = std::min(_frame.width - 1, std::max(0, x1));
+	x2 = std::min(_frame.width - 1, std::max(0, x2));
+	y1 = std::min(_frame.height - 1, std::max(0, y1));
+	y2 = std::min(_frame.height - 1, std::max(0, y2));
+	mark_dirty(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2));
+
+	float x = x1;
+	int screen_x, pixel;
+	for (int y = y1; y < y2; ++y) {
+
+		screen_x = (int)x;
+		pixel = 4 * (_frame.width * y + screen_x);
+		_frame.colorBufferData[pixel] = color[0];
+		_frame.colorBufferData[pixel + 1] = color[1];
+		_frame.colorBufferData[pixel + 2] = color[2];
+		_frame.colorBufferData[pixel + 3] = color[3];
+
+		x += dxdy;
+	}
+
+}
+
+void Engine::draw_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2) {
+
+	if (x1 == x2) {
+		if (y1 < y2) {
+			draw_vertical_line(r, g, b, x1, y1, y2);
+		}
+		else {
+			draw_vertical_line(r, g, b, x1, y2, y1);
+		}
+		return;
+	}
+
+	if (y1 == y2) {
+		if (x1 < x2) {
+			draw_horizontal_line_avx2(r, g, b, x1, x2, y1);
+		}
+		else {
+			draw_horizontal_line_avx2(r, g, b, x2, x1, y1);
+		}
+		return;
+	}
+
+	if (abs(y2 - y1) < abs(x2 - x1)) {
+		if (x1 < x2) {
+			draw_shallow_line_bresenham(r, g, b, x1, y1, x2, y2);
+		}
+		else {
+			draw_shallow_line_bresenham(r, g, b, x2, y2, x1, y1);
+		}
+		return;
+	}
+
+	if (y1 < y2) {
+		draw_steep_line_bresenham(r, g, b, x1, y1, x2, y2);
+	}
+	else {
+		draw_steep_line_bresenham(r, g, b, x2, y2, x1, y1);
+	}
+}
+
+void Engine::draw_shallow_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2) {
+
+	flush_bins();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	unsigned char* color = convert_color(r, g, b);
+
+	x1 = std::min(_frame.width - 1, std::max(0, x1));
+	x2 = std::min(_frame.width - 1, std::max(0, x2));
+	y1 = std::min(_frame.height - 1, std::max(0, y1));
+	y2 = std::min(_frame.height - 1, std::max(0, y2));
+	mark_dirty(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2));
+
+	int dx = x2 - x1;
+	int dy = y2 - y1;
+	int yInc = 1;
+	if (dy < 0) {
+		yInc = -1;
+		dy *= -1;
+	}
+
+	int D = 2 * dy - dx;
+	int dDInc = 2 * (dy - dx);
+	int dDNoInc = 2 * dy;
+
+	int pixel;
+	int y = y1;
+	for (int x = x1; x < x2; ++x) {
+
+		pixel = 4 * (_frame.width * y + x);
+		_frame.colorBufferData[pixel] = color[0];
+		_frame.colorBufferData[pixel + 1] = color[1];
+		_frame.colorBufferData[pixel + 2] = color[2];
+		_frame.colorBufferData[pixel + 3] = color[3];
+
+		if (D > 0) {
+			y += yInc;
+			D += dDInc;
+		}
+		else {
+			D += dDNoInc;
+		}
+	}
+
+}
+
+void Engine::draw_steep_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2) {
+
+	flush_bins();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	unsigned char* color = convert_color(r, g, b);
+
+	x1 = std::min(_frame.width - 1, std::max(0, x1));
+	x2 = std::min(_frame.width - 1, std::max(0, x2));
+	y1 = std::min(_frame.height - 1, std::max(0, y1));
+	y2 = std::min(_frame.height - 1, std::max(0, y2));
+	mark_dirty(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2));
+
+	int dx = x2 - x1;
+	int dy = y2 - y1;
+	int xInc = 1;
+	if (dx < 0) {
+		xInc = -1;
+		dx *= -1;
+	}
+
+	int D = 2 * dx - dy;
+	int dDInc = 2 * (dx - dy);
+	int dDNoInc = 2 * dx;
+
+	int pixel;
+	int x = x1;
+	for (int y = y1; y < y2; ++y) {
+
+		pixel = 4 * (_frame.width * y + x);
+		_frame.colorBufferData[pixel] = color[0];
+		_frame.colorBufferData[pixel + 1] = color[1];
+		_frame.colorBufferData[pixel + 2] = color[2];
+		_frame.colorBufferData[pixel + 3] = color[3];
+
+		if (D > 0) {
+			x += xInc;
+			D += dDInc;
+		}
+		else {
+			D += dDNoInc;
+		}
+	}
+
+}
+
+void Engine::draw_polygon_flat(float r, float g, float b, edgeTable polygon) {
+
+	PROFILE_SCOPE(rasterize);
+
+	flush_bins();
+
+	mark_dirty(polygon);
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+	int* x_start = scanlineStartX.data();
+	int* x_end = scanlineEndX.data();
+	int y_min = _frame.height;
+	int y_max = 0;
+
+	for (int i = 0; i < polygon.vertexCount; ++i) {
+
+		int y = subpixel_to_pixel(snap_to_subpixel(polygon.vertices[i].data[1]));
+		y_min = std::min(y_min, std::max(0, y));
+		y_max = std::max(y_max, std::min(_frame.height - 1, y));
+	}
+
+	for (int y = y_min; y <= y_max; ++y) {
+		x_start[y] = std::numeric_limits<int>::max();
+		x_end[y] = std::numeric_limits<int>::min();
+	}
+
+	for (int j = 0; j < polygon.vertexCount; ++j) {
+		int k = (j + 1) % polygon.vertexCount;
+		trace_edge(
+			snap_to_subpixel(polygon.vertices[j].data[0]), snap_to_subpixel(polygon.vertices[j].data[1]),
+			snap_to_subpixel(polygon.vertices[k].data[0]), snap_to_subpixel(polygon.vertices[k].data[1]),
+			x_start, x_end
+		);
+	}
+
+	for (int y = y_min; y <= y_max; ++y) {
+		if (x_start[y] >= x_end[y]) {
+			continue;
+		}
+		if (overdrawCounting) {
+			count_span_overdraw(x_start[y], x_end[y], y);
+		}
+		draw_horizontal_line_avx2(r, g, b, x_start[y], x_end[y], y);
+	}
+}
+
+/**
+* Widen the spans of the rows an edge crosses to reach it. Corners are in 28.4
+* fixed point, and each row's span runs from its first pixel on or right of the
+* left edge up to (but not including) the first on or right of the right edge.
+*/
+void Engine::trace_edge(int x1, int y1, int x2, int y2, int* x_start, int* x_end) {
+
+	//walked top down whichever way round it was given, so shared edges match
+	if (y1 > y2) {
+		std::swap(x1, x2);
+		std::swap(y1, y2);
+	}
+
+	edgeStepper edge = make_edge_stepper(x1, y1, x2, y2, 0, swapchainFrames[frameNumber].height);
+
+	for (; edge.y < edge.yEnd; advance_edge(edge)) {
+		x_start[edge.y] = std::min(x_start[edge.y], edge.x);
+		x_end[edge.y] = std::max(x_end[edge.y], edge.x);
+	}
+}
+
+/**
+* Snap a polygon's corners to 28.4 fixed point, into a table reused by every
+* polygon drawn immediately. Perspective correct polygons carry their
+* attributes divided by w.
+*/
+vertex* Engine::snap_corners(const edgeTable& polygon, bool perspectiveCorrect) {
+
+	if (static_cast<int>(snappedCorners.size()) < polygon.vertexCount) {
+		snappedCorners.resize(polygon.vertexCount);
+	}
+
+	for (int j = 0; j < polygon.vertexCount; ++j) {
+		snappedCorners[j].x = snap_to_subpixel(polygon.vertices[j].data[0]);
+		snappedCorners[j].y = snap_to_subpixel(polygon.vertices[j].data[1]);
+		snappedCorners[j].attributes = perspectiveCorrect
+			? linalgMakePerspectivePayload(polygon.payloads[j], polygon.vertices[j].data[3])
+			: polygon.payloads[j];
+	}
+
+	return snappedCorners.data();
+}
+
+void Engine::draw_polygon_blended(edgeTable polygon) {
+
+	PROFILE_SCOPE(rasterize);
+
+	mark_dirty(polygon);
+
+	if (tileBinning) {
+		vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+		bins.add_polygon(polygon, nullptr, false, false, _frame.width, _frame.height);
+		return;
+	}
+
+	if (depthTest && hiZ.occluded(polygon)) {
+		++occludedPolygons;
+		return;
+	}
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+	vertex* vertex_start = scanlineStart.data();
+	vertex* vertex_end = scanlineEnd.data();
+	int y_min = _frame.height;
+	int y_max = 0;
+
+	vertex* corners = snap_corners(polygon, false);
+	for (int j = 0; j < polygon.vertexCount; ++j) {
+		int y = subpixel_to_pixel(corners[j].y);
+		y_min = std::min(y_min, std::max(0, y));
+		y_max = std::max(y_max, std::min(_frame.height - 1, y));
+	}
+
+	for (int y = y_min; y <= y_max; ++y) {
+		vertex_start[y].x = std::numeric_limits<int>::max();
+		vertex_end[y].x = std::numeric_limits<int>::min();
+	}
+
+	for (int j = 0; j < polygon.vertexCount; ++j) {
+		interpolate_edge(corners[j], corners[(j + 1) % polygon.vertexCount], vertex_start, vertex_end);
+	}
+
+	for (int y = y_min; y <= y_max; ++y) {
+		if (vertex_start[y].x >= vertex_end[y].x) {
+			continue;
+		}
+		if (overdrawCounting) {
+			count_span_overdraw(vertex_start[y].x, vertex_end[y].x, y);
+		}
+		draw_horizontal_line_blended(vertex_start[y], vertex_end[y], y);
+	}
+
+	if (depthTest) {
+		hiZ.update(swapchainFrames[frameNumber].depthBufferData.data(), polygon);
+	}
+}
+
+/**
+* Trace an edge into the scanline tables exactly as trace_edge does, carrying
+* the attributes along. Each row gets the attributes where the edge crosses
+* its centre line, evaluated from the top corner rather than accumulated.
+*/
+void Engine::interpolate_edge(vertex v1, vertex v2, vertex* vertex_start, vertex* vertex_end) {
+
+	if (v1.y > v2.y) {
+		std::swap(v1, v2);
+	}
+
+	edgeStepper edge = make_edge_stepper(v1.x, v1.y, v2.x, v2.y, 0, swapchainFrames[frameNumber].height);
+	if (edge.y >= edge.yEnd) {
+		return;
+	}
+
+	__m256 dP = _mm256_sub_ps(v2.attributes.lump, v1.attributes.lump);
+	float invHeight = 1.0f / (float)(v2.y - v1.y);
+
+	for (; edge.y < edge.yEnd; advance_edge(edge)) {
+
+		int y = edge.y;
+		bool starts = edge.x < vertex_start[y].x;
+		bool ends = edge.x > vertex_end[y].x;
+		if (!starts && !ends) {
+			continue;
+		}
+
+		payload crossing;
+		float t = (float)(subpixelScale * y + subpixelScale / 2 - v1.y) * invHeight;
+		crossing.lump = _mm256_fmadd_ps(_mm256_set1_ps(t), dP, v1.attributes.lump);
+
+		if (starts) {
+			vertex_start[y].x = edge.x;
+			vertex_start[y].attributes = crossing;
+		}
+
+		if (ends) {
+			vertex_end[y].x = edge.x;
+			vertex_end[y].attributes = crossing;
+		}
+	}
+}
+
+void Engine::draw_horizontal_line_blended(vertex v1, vertex v2, int y) {
+
+	draw_horizontal_line_blended(v1, v2, y, 0, swapchainFrames[frameNumber].width);
+}
+
+/**
+* Draw the part of a color blended span which lies within [clip_x1, clip_x2).
+* Attributes are evaluated from the span's start for every pixel, rather than
+* accumulated, so a pixel shades the same no matter how the span is clipped.
+*/
+void Engine::draw_horizontal_line_blended(vertex v1, vertex v2, int y, int clip_x1, int clip_x2) {
+
+	(this->*blendedSpan)(v1, v2, y, clip_x1, clip_x2);
+}
+
+template<vk::Format format>
+void Engine::shade_blended_span(vertex v1, vertex v2, int y, int clip_x1, int clip_x2) {
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	//only the pixels are scissored to the screen, not the span, so the
+	//attributes of spans reaching past the edges don't get squeezed
+	int x1 = v1.x;
+	int x2 = v2.x;
+	y = std::min(_frame.height - 1, std::max(0, y));
+	payload fragment;
+	__m256 dPdx = _mm256_div_ps(
+		_mm256_sub_ps(v2.attributes.lump, v1.attributes.lump),
+		_mm256_set1_ps(x2 - x1)
+	);
+
+	int x_begin = std::max(x1, std::max(0, clip_x1));
+	int x_end = std::min(x2, std::min(_frame.width, clip_x2));
+	float* depth = _frame.depthBufferData.data() + _frame.width * y;
+	uint32_t* pixels = reinterpret_cast<uint32_t*>(_frame.colorBufferData) + _frame.width * y;
+	uint64_t rejected = 0;
+
+	for (int x = x_begin; x < x_end; ++x) {
+
+		fragment.lump = _mm256_fmadd_ps(_mm256_set1_ps((float)(x - x1)), dPdx, v1.attributes.lump);
+
+		if (depthTest) {
+			if (!(fragment.data[5] < depth[x])) {
+				++rejected;
+				continue;
+			}
+			depth[x] = fragment.data[5];
+		}
+
+		pixels[x] = pack_color<format>(fragment.data[0], fragment.data[1], fragment.data[2]);
+	}
+
+	if (rejected) {
+		rejectedFragments += rejected;
+	}
+}
+
+/**
+* Convert 8 bit RGBA pixels to a texture and build its mip chain. Every level
+* of a channel (or of the packed texels) lives in the one allocation.
+*
+* @param layout	how to store the texels, the mip chain is always built planar first
+*/
+texture Engine::convert_texture(stbi_uc* textureData, int width, int height, textureLayout layout) {
+
+	texture tex;
+	tex.width = width;
+	tex.height = height;
+	tex.texels = nullptr;
+	tex.tilesPerRow = 0;
+
+	tex.levelCount = 1;
+	size_t texelCount = (size_t)width * height;
+	for (int w = width, h = height; w > 1 || h > 1; ++tex.levelCount) {
+		w = std::max(1, w / 2);
+		h = std::max(1, h / 2);
+		texelCount += (size_t)w * h;
+	}
+
+	tex.r = (float*)malloc(texelCount * sizeof(float));
+	tex.g = (float*)malloc(texelCount * sizeof(float));
+	tex.b = (float*)malloc(texelCount * sizeof(float));
+	tex.levels = (texture*)malloc(tex.levelCount * sizeof(texture));
+
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			tex.r[width * y + x] = (float)textureData[4 * (width * y + x)] / 255;
+			tex.g[width * y + x] = (float)textureData[4 * (width * y + x) + 1] / 255;
+			tex.b[width * y + x] = (float)textureData[4 * (width * y + x) + 2] / 255;
+		}
+	}
+
+	size_t offset = 0;
+	for (int i = 0; i < tex.levelCount; ++i) {
+
+		texture& level = tex.levels[i];
+		level.width = (i == 0) ? width : std::max(1, tex.levels[i - 1].width / 2);
+		level.height = (i == 0) ? height : std::max(1, tex.levels[i - 1].height / 2);
+		level.r = tex.r + offset;
+		level.g = tex.g + offset;
+		level.b = tex.b + offset;
+		level.texels = nullptr;
+		level.tilesPerRow = 0;
+		level.levels = nullptr;
+		level.levelCount = 0;
+		offset += (size_t)level.width * level.height;
+
+		if (i > 0) {
+			downsample_box_avx2(tex.levels[i - 1], level);
+		}
+	}
+
+	if (layout == textureLayout::packedTiled) {
+		pack_texture_tiled(tex);
+	}
+
+	return tex;
+}
+
+/**
+* Free everything convert_texture allocated, whichever the layout.
+*/
+void Engine::free_texture(texture& tex) {
+
+	free(tex.r);
+	free(tex.g);
+	free(tex.b);
+	if (tex.texels) {
+		operator delete(tex.texels, std::align_val_t(64));
+	}
+	free(tex.levels);
+
+	tex.r = tex.g = tex.b = nullptr;
+	tex.texels = nullptr;
+	tex.levels = nullptr;
+	tex.levelCount = 0;
+}
+
+/**
+* Choose how textures are filtered between mip levels, polygons already
+* waiting in the bins are rasterized first so they keep the old filter.
+*/
+void Engine::set_texture_filter(textureFilter filter) {
+
+	if (filter != this->filter) {
+		flush_bins();
+	}
+
+	this->filter = filter;
+}
+
+void Engine::draw_polygon_textured(edgeTable& polygon, texture& tex) {
+
+	PROFILE_SCOPE(rasterize);
+
+	mark_dirty(polygon);
+
+	if (tileBinning) {
+		vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+		bins.add_polygon(polygon, &tex, false, perspective != perspectiveMode::affine, _frame.width, _frame.height);
+		return;
+	}
+
+	if (depthTest && hiZ.occluded(polygon)) {
+		++occludedPolygons;
+		return;
+	}
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+	vertex* vertex_start = scanlineStart.data();
+	vertex* vertex_end = scanlineEnd.data();
+	int y_min = _frame.height;
+	int y_max = 0;
+
+	vertex* corners = snap_corners(polygon, perspective != perspectiveMode::affine);
+	for (int j = 0; j < polygon.vertexCount; ++j) {
+		int y = subpixel_to_pixel(corners[j].y);
+		y_min = std::min(y_min, std::max(0, y));
+		y_max = std::max(y_max, std::min(_frame.height - 1, y));
+	}
+	payload dPdy = attribute_gradient_y(corners, polygon.vertexCount);
+
+	for (int y = y_min; y <= y_max; ++y) {
+		vertex_start[y].x = std::numeric_limits<int>::max();
+		vertex_end[y].x = std::numeric_limits<int>::min();
+	}
+
+	for (int j = 0; j < polygon.vertexCount; ++j) {
+		interpolate_edge(corners[j], corners[(j + 1) % polygon.vertexCount], vertex_start, vertex_end);
+	}
+
+	for (int y = y_min; y <= y_max; ++y) {
+		if (vertex_start[y].x >= vertex_end[y].x) {
+			continue;
+		}
+		if (overdrawCounting) {
+			count_span_overdraw(vertex_start[y].x, vertex_end[y].x, y);
+		}
+		draw_horizontal_line_textured(vertex_start[y], vertex_end[y], y, tex, dPdy);
+	}
+
+	if (depthTest) {
+		hiZ.update(swapchainFrames[frameNumber].depthBufferData.data(), polygon);
+	}
+}
+
+void Engine::draw_horizontal_line_textured(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy) {
+
+	draw_horizontal_line_textured(v1, v2, y, tex, dPdy, 0, swapchainFrames[frameNumber].width);
+}
+
+/**
+* Draw the part of a textured span which lies within [clip_x1, clip_x2),
+* attributes are evaluated per pixel exactly as in draw_horizontal_line_blended.
+* The mip levels are chosen once, from the derivatives at the middle of the
+* on screen part of the span (dPdy being the polygon's rate of change per row),
+* so a span split across tiles makes the same choice in each of them.
+*/
+void Engine::draw_horizontal_line_textured(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy, int clip_x1, int clip_x2) {
+
+	(this->*texturedSpan)(v1, v2, y, tex, dPdy, clip_x1, clip_x2);
+}
+
+template<vk::Format format>
+void Engine::shade_textured_span(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy, int clip_x1, int clip_x2) {
+
+	if (simdSpans) {
+		draw_horizontal_line_textured_avx2<format>(v1, v2, y, tex, dPdy, clip_x1, clip_x2);
+		return;
+	}
+
+	if (perspective != perspectiveMode::affine) {
+		draw_horizontal_line_textured_perspective<format>(v1, v2, y, tex, dPdy, clip_x1, clip_x2);
+		return;
+	}
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	int x1 = v1.x;
+	int x2 = v2.x;
+	y = std::min(_frame.height - 1, std::max(0, y));
+	payload fragment;
+	__m256 dPdx = _mm256_div_ps(
+		_mm256_sub_ps(v2.attributes.lump, v1.attributes.lump),
+		_mm256_set1_ps(x2 - x1)
+	);
+
+	int x_begin = std::max(x1, std::max(0, clip_x1));
+	int x_end = std::min(x2, std::min(_frame.width, clip_x2));
+
+	payload middle, gradient;
+	middle.lump = _mm256_fmadd_ps(_mm256_set1_ps(0.5f * (std::max(x1, 0) + std::min(x2, _frame.width)) - x1), dPdx, v1.attributes.lump);
+	gradient.lump = dPdx;
+	mipSelection mips = select_mip_levels(tex, level_of_detail(tex, middle, gradient, dPdy, false), filter);
+	float* depth = _frame.depthBufferData.data() + _frame.width * y;
+	uint32_t* pixels = reinterpret_cast<uint32_t*>(_frame.colorBufferData) + _frame.width * y;
+	uint64_t rejected = 0;
+
+	for (int x = x_begin; x < x_end; ++x) {
+
+		fragment.lump = _mm256_fmadd_ps(_mm256_set1_ps((float)(x - x1)), dPdx, v1.attributes.lump);
+
+		//early depth test, hidden fragments never touch the texture
+		if (depthTest) {
+			if (!(fragment.data[5] < depth[x])) {
+				++rejected;
+				continue;
+			}
+			depth[x] = fragment.data[5];
+		}
+
+		float r, g, b;
+		sample_mipmapped(mips, fragment.data[3], fragment.data[4], r, g, b);
+
+		pixels[x] = pack_color<format>(fragment.data[0] * r, fragment.data[1] * g, fragment.data[2] * b);
+	}
+
+	if (rejected) {
+		rejectedFragments += rejected;
+	}
+}
+
+/**
+* Draw a textured span whose attributes have been divided by w, with 1/w in lane 7.
+* attribute/w and 1/w are linear in screen space, so they're interpolated as usual
+* and divided back out. The exact mode divides at every pixel, the subdivided modes
+* only correct at every 8th or 16th pixel from the span's start (with a reciprocal
+* estimate and a Newton step) and interpolate linearly in between.
+*/
+template<vk::Format format>
+void Engine::draw_horizontal_line_textured_perspective(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy, int clip_x1, int clip_x2) {
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	int x1 = v1.x;
+	int x2 = v2.x;
+	y = std::min(_frame.height - 1, std::max(0, y));
+	payload fragment;
+	__m256 dPdx = _mm256_div_ps(
+		_mm256_sub_ps(v2.attributes.lump, v1.attributes.lump),
+		_mm256_set1_ps(x2 - x1)
+	);
+
+	int x_begin = std::max(x1, std::max(0, clip_x1));
+	int x_end = std::min(x2, std::min(_frame.width, clip_x2));
+
+	payload middle, gradient;
+	middle.lump = _mm256_fmadd_ps(_mm256_set1_ps(0.5f * (std::max(x1, 0) + std::min(x2, _frame.width)) - x1), dPdx, v1.attributes.lump);
+	gradient.lump = dPdx;
+	mipSelection mips = select_mip_levels(tex, level_of_detail(tex, middle, gradient, dPdy, true), filter);
+
+	int step = 1;
+	if (perspective == perspectiveMode::subdivide8) {
+		step = 8;
+	}
+	else if (perspective == perspectiveMode::subdivide16) {
+		step = 16;
+	}
+
+	//lane 7 of a payload, broadcast
+	__m256i wLane = _mm256_set1_epi32(7);
+	//depth (lane 5) is linear in screen space already, so it's never divided
+	const int depthLane = 1 << 5;
+	float* depth = _frame.depthBufferData.data() + _frame.width * y;
+	uint32_t* pixels = reinterpret_cast<uint32_t*>(_frame.colorBufferData) + _frame.width * y;
+	uint64_t rejected = 0;
+
+	//segments are counted from the span's start, so clipping doesn't move them
+	int x_segment = x1 + step * ((x_begin - x1) / step);
+	__m256 q = _mm256_fmadd_ps(_mm256_set1_ps((float)(x_segment - x1)), dPdx, v1.attributes.lump);
+	__m256 segmentStart = _mm256_mul_ps(q, reciprocal_avx2(_mm256_permutevar8x32_ps(q, wLane)));
+	segmentStart = _mm256_blend_ps(segmentStart, q, depthLane);
+
+	for (; x_segment < x_end; x_segment += step) {
+
+		int segmentLength = std::min(step, x2 - x_segment);
+		__m256 segmentEnd;
+		__m256 dAdx;
+
+		if (step == 1) {
+			//exact, a true division at every pixel
+			q = _mm256_fmadd_ps(_mm256_set1_ps((float)(x_segment - x1)), dPdx, v1.attributes.lump);
+			segmentStart = _mm256_blend_ps(_mm256_div_ps(q, _mm256_permutevar8x32_ps(q, wLane)), q, depthLane);
+			segmentEnd = segmentStart;
+			dAdx = _mm256_setzero_ps();
+		}
+		else {
+			q = _mm256_fmadd_ps(_mm256_set1_ps((float)(x_segment + segmentLength - x1)), dPdx, v1.attributes.lump);
+			segmentEnd = _mm256_mul_ps(q, reciprocal_avx2(_mm256_permutevar8x32_ps(q, wLane)));
+			segmentEnd = _mm256_blend_ps(segmentEnd, q, depthLane);
+			dAdx = _mm256_div_ps(_mm256_sub_ps(segmentEnd, segmentStart), _mm256_set1_ps((float)segmentLength));
+		}
+
+		int x_stop = std::min(x_segment + step, x_end);
+		for (int x = std::max(x_segment, x_begin); x < x_stop; ++x) {
+
+			fragment.lump = _mm256_fmadd_ps(_mm256_set1_ps((float)(x - x_segment)), dAdx, segmentStart);
+
+			if (depthTest) {
+				if (!(fragment.data[5] < depth[x])) {
+					++rejected;
+					continue;
+				}
+				depth[x] = fragment.data[5];
+			}
+
+			float r, g, b;
+			sample_mipmapped(mips, fragment.data[3], fragment.data[4], r, g, b);
+
+			pixels[x] = pack_color<format>(fragment.data[0] * r, fragment.data[1] * g, fragment.data[2] * b);
+		}
+
+		segmentStart = segmentEnd;
+	}
+
+	if (rejected) {
+		rejectedFragments += rejected;
+	}
+}
+
+/**
+* Draw a textured span eight fragments at a time: the payload lanes are interpolated
+* for a block of pixels at once, depth tested, sampled, modulated by the vertex color,
+* packed to the swapchain's format and written with a single masked 32 byte store.
+* Mip levels are chosen exactly as in draw_horizontal_line_textured. Perspective
+* correct spans divide by the interpolated 1/w at every pixel whichever mode is
+* set, since a block costs the same reciprocal as a subdivided segment.
+*/
+template<vk::Format format>
+void Engine::draw_horizontal_line_textured_avx2(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy, int clip_x1, int clip_x2) {
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	int x1 = v1.x;
+	int x2 = v2.x;
+	y = std::min(_frame.height - 1, std::max(0, y));
+	payload dPdx;
+	dPdx.lump = _mm256_div_ps(
+		_mm256_sub_ps(v2.attributes.lump, v1.attributes.lump),
+		_mm256_set1_ps(x2 - x1)
+	);
+
+	int x_begin = std::max(x1, std::max(0, clip_x1));
+	int x_end = std::min(x2, std::min(_frame.width, clip_x2));
+	if (x_begin >= x_end) {
+		return;
+	}
+
+	bool perspectiveCorrect = perspective != perspectiveMode::affine;
+	payload middle;
+	middle.lump = _mm256_fmadd_ps(_mm256_set1_ps(0.5f * (std::max(x1, 0) + std::min(x2, _frame.width)) - x1), dPdx.lump, v1.attributes.lump);
+	mipSelection mips = select_mip_levels(tex, level_of_detail(tex, middle, dPdx, dPdy, perspectiveCorrect), filter);
+
+	const __m256 laneOffsets = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+	const __m256i laneIndices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+	//lanes 0-4 are shaded with, 5 is depth and 7 is 1/w
+	__m256 start[8], slope[8];
+	for (int k = 0; k < 8; ++k) {
+		start[k] = _mm256_set1_ps(v1.attributes.data[k]);
+		slope[k] = _mm256_set1_ps(dPdx.data[k]);
+	}
+
+	float* depth = _frame.depthBufferData.data() + _frame.width * y;
+	uint32_t* pixels = reinterpret_cast<uint32_t*>(_frame.colorBufferData) + _frame.width * y;
+	uint64_t rejected = 0;
+
+	for (int x = x_begin; x < x_end; x += 8) {
+
+		//lanes past the end of the span are masked off
+		__m256i inside = _mm256_cmpgt_epi32(_mm256_set1_epi32(x_end - x), laneIndices);
+		__m256 t = _mm256_add_ps(_mm256_set1_ps((float)(x - x1)), laneOffsets);
+
+		if (depthTest) {
+			__m256 z = _mm256_fmadd_ps(t, slope[5], start[5]);
+			__m256 stored = _mm256_maskload_ps(depth + x, inside);
+			__m256 passed = _mm256_and_ps(_mm256_castsi256_ps(inside), _mm256_cmp_ps(z, stored, _CMP_LT_OQ));
+
+			int mask = _mm256_movemask_ps(_mm256_castsi256_ps(inside));
+			int passedMask = _mm256_movemask_ps(passed);
+			rejected += _mm_popcnt_u32(mask & ~passedMask);
+			if (passedMask == 0) {
+				continue;
+			}
+			inside = _mm256_castps_si256(passed);
+			_mm256_maskstore_ps(depth + x, inside, z);
+		}
+
+		__m256 attributes[5];
+		for (int k = 0; k < 5; ++k) {
+			attributes[k] = _mm256_fmadd_ps(t, slope[k], start[k]);
+		}
+
+		if (perspectiveCorrect) {
+			__m256 w = reciprocal_avx2(_mm256_fmadd_ps(t, slope[7], start[7]));
+			for (int k = 0; k < 5; ++k) {
+				attributes[k] = _mm256_mul_ps(attributes[k], w);
+			}
+		}
+
+		__m256 r, g, b;
+		sample_mipmapped_avx2(mips, attributes[3], attributes[4], r, g, b);
+
+		__m256i color = pack_colors_avx2<format>(
+			_mm256_mul_ps(r, attributes[0]),
+			_mm256_mul_ps(g, attributes[1]),
+			_mm256_mul_ps(b, attributes[2]));
+		_mm256_maskstore_epi32(reinterpret_cast<int*>(pixels + x), inside, color);
+	}
+
+	if (rejected) {
+		rejectedFragments += rejected;
+	}
+}
+
+/**
+* Choose whether textured spans are drawn by the scalar loops or eight fragments
+* at a time, bins already filled are flushed by whichever was chosen before.
+*/
+void Engine::set_simd_spans(bool enabled) {
+
+	if (enabled != simdSpans) {
+		flush_bins();
+	}
+
+	simdSpans = enabled;
+}
+
+/**
+* Choose how textured polygons interpolate their attributes, polygons already
+* waiting in the bins are rasterized first since they were set up for the old mode.
+*/
+void Engine::set_perspective_mode(perspectiveMode mode) {
+
+	if (mode != perspective) {
+		flush_bins();
+	}
+
+	perspective = mode;
+}
+
+/**
+* Turn depth testing on or off. While it's on, blended and textured polygons
+* only draw fragments closer than what's already there (depth comes from payload
+* lane 5, smaller is closer) and clearing the screen clears depth as well.
+*/
+void Engine::set_depth_test(bool enabled) {
+
+	flush_bins();
+
+	depthTest = enabled;
+}
+
+/**
+* The number of fragments which failed the depth test since the screen was last cleared.
+*/
+uint64_t Engine::get_rejected_fragment_count() {
+
+	return rejectedFragments;
+}
+
+/**
+* Conservatively test a polygon against the coarse depth blocks before it's
+* clipped, so hidden geometry can skip clipping and rasterization entirely.
+* Only polygons rasterized so far count as occluders, so while tile binning is
+* on, callers flush the bins after each object to have it cull the ones after.
+*
+* @param clipVertices	the polygon's corners in clip space (after projection)
+* @param vertexCount	the number of corners
+* @returns whether the polygon is sure to be hidden
+*/
+bool Engine::is_occluded(vec4* clipVertices, int vertexCount) {
+
+	if (!depthTest) {
+		return false;
+	}
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	float x_min = (float)_frame.width;
+	float x_max = 0.0f;
+	float y_min = (float)_frame.height;
+	float y_max = 0.0f;
+	float nearestDepth = 1.0f;
+
+	for (int i = 0; i < vertexCount; ++i) {
+
+		float w = clipVertices[i].data[3];
+
+		//behind the eye, the projected bounds mean nothing
+		if (w <= 0.0f) {
+			return false;
+		}
+
+		float x = viewport.centerX + viewport.scaleX * clipVertices[i].data[0] / w;
+		float y = viewport.centerY + viewport.scaleY * clipVertices[i].data[1] / w;
+		x_min = std::min(x_min, x);
+		x_max = std::max(x_max, x);
+		y_min = std::min(y_min, y);
+		y_max = std::max(y_max, y);
+		nearestDepth = std::min(nearestDepth, clipVertices[i].data[2] / w);
+	}
+
+	//a polygon entirely off screen is the clipper's problem
+	if (x_max < 0.0f || y_max < 0.0f || x_min >= _frame.width || y_min >= _frame.height) {
+		return false;
+	}
+
+	if (hiZ.occluded(nearestDepth, (int)x_min, (int)y_min, (int)x_max, (int)y_max)) {
+		++occludedPolygons;
+		return true;
+	}
+
+	return false;
+}
+
+/**
+* The number of polygons thrown away by coarse occlusion tests since the screen was last cleared,
+* while tile binning is on each tile a polygon is skipped in counts once.
+*/
+uint64_t Engine::get_occluded_polygon_count() {
+
+	return occludedPolygons;
+}
+
+/**
+* Turn overdraw counting on or off. While it's on, every pixel the polygon
+* rasterizers cover is recorded, before any depth test, and each fragment
+* landing on a pixel covered since the last clear is counted as overdraw.
+* The front faces of a closed mesh should cover every pixel at most once.
+*/
+void Engine::set_overdraw_counting(bool enabled) {
+
+	flush_bins();
+
+	if (enabled && !overdrawCounting) {
+		covered.assign(swapchainExtent.width * swapchainExtent.height, 0);
+		overdrawnFragments = 0;
+	}
+
+	overdrawCounting = enabled;
+}
+
+/**
+* Get the number of fragments rasterized onto already covered pixels since
+* the screen was last cleared, or since counting was turned on.
+*/
+uint64_t Engine::get_overdraw_count() {
+
+	return overdrawnFragments;
+}
+
+void Engine::count_span_overdraw(int x1, int x2, int y) {
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	uint8_t* row = covered.data() + _frame.width * y;
+	uint64_t overdrawn = 0;
+	for (int x = std::max(0, x1); x < std::min(_frame.width, x2); ++x) {
+		overdrawn += row[x];
+		row[x] = 1;
+	}
+
+	if (overdrawn) {
+		overdrawnFragments += overdrawn;
+	}
+}
+
+void Engine::count_block_overdraw(int x, int y, int mask) {
+
+	uint8_t* block = covered.data() + swapchainFrames[frameNumber].width * y + x;
+	uint64_t overdrawn = 0;
+	for (; mask; mask &= mask - 1) {
+		int lane = _mm_popcnt_u32((mask & -mask) - 1);
+		overdrawn += block[lane];
+		block[lane] = 1;
+	}
+
+	if (overdrawn) {
+		overdrawnFragments += overdrawn;
+	}
+}
+
+void Engine::draw_polygon_blended_halfspace(edgeTable& polygon) {
+
+	PROFILE_SCOPE(rasterize);
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+	mark_dirty(polygon);
+
+	if (tileBinning) {
+		bins.add_polygon(polygon, nullptr, true, false, _frame.width, _frame.height);
+		return;
+	}
+
+	if (depthTest && hiZ.occluded(polygon)) {
+		++occludedPolygons;
+		return;
+	}
+
+	rasterize_halfspace(snap_corners(polygon, false), polygon.vertexCount, nullptr, 0, 0, _frame.width, _frame.height);
+
+	if (depthTest) {
+		hiZ.update(_frame.depthBufferData.data(), polygon);
+	}
+}
+
+void Engine::draw_polygon_textured_halfspace(edgeTable& polygon, texture& tex) {
+
+	PROFILE_SCOPE(rasterize);
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+	mark_dirty(polygon);
+
+	if (tileBinning) {
+		bins.add_polygon(polygon, &tex, true, perspective != perspectiveMode::affine, _frame.width, _frame.height);
+		return;
+	}
+
+	if (depthTest && hiZ.occluded(polygon)) {
+		++occludedPolygons;
+		return;
+	}
+
+	rasterize_halfspace(snap_corners(polygon, perspective != perspectiveMode::affine), polygon.vertexCount, &tex, 0, 0, _frame.width, _frame.height);
+
+	if (depthTest) {
+		hiZ.update(_frame.depthBufferData.data(), polygon);
+	}
+}
+
+/**
+* Rasterize a convex polygon with edge functions, as a fan of triangles.
+* Every row is walked in aligned blocks of 8 pixels, the three edge functions
+* and the barycentric coordinates are evaluated for the whole block at once
+* and their signs give the block's coverage mask. Coverage is decided in exact
+* integers under the top-left rule, so triangles sharing an edge (the fan's own
+* included) never both cover a pixel. Only the pixels within
+* [clip_x1, clip_x2) x [clip_y1, clip_y2) are touched. Outside of affine mode
+* textured blocks are perspective corrected at every pixel.
+*
+* @param corners	the polygon's corners, snapped to 28.4 fixed point
+* @param cornerCount	the number of corners
+* @param tex		the texture to sample, or null to just blend vertex colors
+*/
+void Engine::rasterize_halfspace(vertex* corners, int cornerCount, texture* tex,
+	int clip_x1, int clip_y1, int clip_x2, int clip_y2) {
+
+	(this->*halfspaceBlocks)(corners, cornerCount, tex, clip_x1, clip_y1, clip_x2, clip_y2);
+}
+
+template<vk::Format format>
+void Engine::shade_halfspace(vertex* corners, int cornerCount, texture* tex,
+	int clip_x1, int clip_y1, int clip_x2, int clip_y2) {
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	clip_x1 = std::max(0, clip_x1);
+	clip_y1 = std::max(0, clip_y1);
+	clip_x2 = std::min(_frame.width, clip_x2);
+	clip_y2 = std::min(_frame.height, clip_y2);
+
+	const __m256 laneOffsets = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+	//edge function values are clamped to this before they're stepped across a block,
+	//far beyond anything eight pixels of stepping can cross
+	const int64_t coverageLimit = 1 << 30;
+
+	//textured corners carry attribute/w in every mode but affine
+	bool perspectiveCorrect = tex != nullptr && perspective != perspectiveMode::affine;
+	uint64_t rejected = 0;
+
+	for (int i = 1; i + 1 < cornerCount; ++i) {
+
+		vertex* triangle[3] = { &corners[0], &corners[i], &corners[i + 1] };
+
+		//twice the area, exactly, in subpixels squared
+		int64_t area = (int64_t)(triangle[1]->x - triangle[0]->x) * (triangle[2]->y - triangle[0]->y)
+			- (int64_t)(triangle[1]->y - triangle[0]->y) * (triangle[2]->x - triangle[0]->x);
+		if (area == 0) {
+			continue;
+		}
+		//whichever the winding, make the inside positive
+		int64_t orientation = area > 0 ? 1 : -1;
+		float invArea = 1.0f / (float)(orientation * area);
+
+		//edge j is opposite corner j: E(x, y) = A x + B y + C on the snapped corners, which
+		//is an exact integer at every pixel centre. A centre exactly on an edge is only
+		//inside for a top or left edge, so inside is E > -1 for those and E > 0 otherwise
+		int64_t A[3], B[3], E0[3];
+		__m256i laneSteps[3], threshold[3];
+		for (int j = 0; j < 3; ++j) {
+			vertex* a = triangle[(j + 1) % 3];
+			vertex* b = triangle[(j + 2) % 3];
+			A[j] = orientation * (a->y - b->y);
+			B[j] = orientation * (b->x - a->x);
+			int64_t C = orientation * ((int64_t)a->x * b->y - (int64_t)a->y * b->x);
+			bool topLeft = A[j] > 0 || (A[j] == 0 && B[j] > 0);
+			threshold[j] = _mm256_set1_epi32(topLeft ? -1 : 0);
+
+			//at the centre of pixel (0, 0), and stepped a whole pixel at a time from there
+			E0[j] = (A[j] + B[j]) * (subpixelScale / 2) + C;
+			A[j] *= subpixelScale;
+			B[j] *= subpixelScale;
+			int step = static_cast<int>(A[j]);
+			laneSteps[j] = _mm256_setr_epi32(0, step, 2 * step, 3 * step, 4 * step, 5 * step, 6 * step, 7 * step);
+		}
+
+		//attribute deltas against corner 0, weighted by barycentrics 1 and 2
+		payload P0 = triangle[0]->attributes;
+		payload dP1, dP2;
+		dP1.lump = _mm256_sub_ps(triangle[1]->attributes.lump, P0.lump);
+		dP2.lump = _mm256_sub_ps(triangle[2]->attributes.lump, P0.lump);
+
+		//the barycentrics' gradients are A/area and B/area, so the attributes' are too
+		payload dPdx, dPdy;
+		dPdx.lump = _mm256_mul_ps(_mm256_fmadd_ps(_mm256_set1_ps((float)A[1]), dP1.lump, _mm256_mul_ps(_mm256_set1_ps((float)A[2]), dP2.lump)), _mm256_set1_ps(invArea));
+		dPdy.lump = _mm256_mul_ps(_mm256_fmadd_ps(_mm256_set1_ps((float)B[1]), dP1.lump, _mm256_mul_ps(_mm256_set1_ps((float)B[2]), dP2.lump)), _mm256_set1_ps(invArea));
+
+		int x_min = std::max(clip_x1, subpixel_to_pixel(std::min({ triangle[0]->x, triangle[1]->x, triangle[2]->x })));
+		int x_max = std::min(clip_x2, subpixel_to_pixel(std::max({ triangle[0]->x, triangle[1]->x, triangle[2]->x })) + 1);
+		int y_min = std::max(clip_y1, subpixel_to_pixel(std::min({ triangle[0]->y, triangle[1]->y, triangle[2]->y })));
+		int y_max = std::min(clip_y2, subpixel_to_pixel(std::max({ triangle[0]->y, triangle[1]->y, triangle[2]->y })) + 1);
+
+		__m256 left = _mm256_set1_ps((float)x_min);
+		__m256 right = _mm256_set1_ps((float)x_max);
+
+		for (int y = y_min; y < y_max; ++y) {
+
+			int64_t rowE[3];
+			for (int j = 0; j < 3; ++j) {
+				rowE[j] = E0[j] + B[j] * y;
+			}
+
+			for (int x = x_min & ~7; x < x_max; x += 8) {
+
+				__m256 px = _mm256_add_ps(_mm256_set1_ps((float)x), laneOffsets);
+
+				__m256 bounds = _mm256_and_ps(
+					_mm256_cmp_ps(px, left, _CMP_GE_OQ),
+					_mm256_cmp_ps(px, right, _CMP_LT_OQ)
+				);
+
+				//the block's first pixel is evaluated exactly, then clamped to 32 bits for the
+				//lanes: a block far enough from an edge to be clamped has every lane on the
+				//same side of it. The float barycentrics start from the same exact value,
+				//which keeps them accurate however far the block is from the origin
+				__m256i inside = _mm256_set1_epi32(-1);
+				__m256 weights[3];
+				for (int j = 0; j < 3; ++j) {
+					int64_t E = rowE[j] + A[j] * x;
+					int clamped = static_cast<int>(std::min(std::max(E, -coverageLimit), coverageLimit));
+					inside = _mm256_and_si256(inside,
+						_mm256_cmpgt_epi32(_mm256_add_epi32(_mm256_set1_epi32(clamped), laneSteps[j]), threshold[j]));
+					weights[j] = _mm256_fmadd_ps(_mm256_set1_ps((float)A[j]), laneOffsets, _mm256_set1_ps((float)E));
+				}
+				__m256 coverage = _mm256_and_ps(bounds, _mm256_castsi256_ps(inside));
+
+				int mask = _mm256_movemask_ps(coverage);
+				if (mask == 0) {
+					continue;
+				}
+
+				if (overdrawCounting) {
+					count_block_overdraw(x, y, mask);
+				}
+
+				__m256 b1 = _mm256_mul_ps(weights[1], _mm256_set1_ps(invArea));
+				__m256 b2 = _mm256_mul_ps(weights[2], _mm256_set1_ps(invArea));
+
+				//early depth test, before anything is sampled. Masked loads and
+				//stores keep lanes past the edge of the screen untouched
+				if (depthTest) {
+					__m256 z = _mm256_fmadd_ps(b1, _mm256_set1_ps(dP1.data[5]),
+						_mm256_fmadd_ps(b2, _mm256_set1_ps(dP2.data[5]), _mm256_set1_ps(P0.data[5])));
+					float* depth = _frame.depthBufferData.data() + _frame.width * y + x;
+					__m256 stored = _mm256_maskload_ps(depth, _mm256_castps_si256(coverage));
+					coverage = _mm256_and_ps(coverage, _mm256_cmp_ps(z, stored, _CMP_LT_OQ));
+
+					int passed = _mm256_movemask_ps(coverage);
+					rejected += _mm_popcnt_u32(mask & ~passed);
+					mask = passed;
+					if (mask == 0) {
+						continue;
+					}
+					_mm256_maskstore_ps(depth, _mm256_castps_si256(coverage), z);
+				}
+
+				//interpolate the payload lanes we shade with, 8 pixels at a time
+				__m256 attributes[5];
+				for (int k = 0; k < 5; ++k) {
+					attributes[k] = _mm256_fmadd_ps(b1, _mm256_set1_ps(dP1.data[k]),
+						_mm256_fmadd_ps(b2, _mm256_set1_ps(dP2.data[k]), _mm256_set1_ps(P0.data[k])));
+				}
+
+				//the corners were divided by w, so divide the interpolated 1/w back out
+				if (perspectiveCorrect) {
+					__m256 w = reciprocal_avx2(_mm256_fmadd_ps(b1, _mm256_set1_ps(dP1.data[7]),
+						_mm256_fmadd_ps(b2, _mm256_set1_ps(dP2.data[7]), _mm256_set1_ps(P0.data[7]))));
+					for (int k = 0; k < 5; ++k) {
+						attributes[k] = _mm256_mul_ps(attributes[k], w);
+					}
+				}
+
+				payload r, g, b;
+				if (tex) {
+					//mip levels are chosen per block, at the middle of its covered pixels
+					int first = _mm_popcnt_u32((mask & -mask) - 1);
+					int below = mask | (mask >> 1);
+					below |= below >> 2;
+					below |= below >> 4;
+					int last = _mm_popcnt_u32(below) - 1;
+					float middleX = 0.5f * (first + last);
+					payload middle;
+					middle.lump = _mm256_fmadd_ps(_mm256_set1_ps(((float)(rowE[1] + A[1] * x) + A[1] * middleX) * invArea), dP1.lump,
+						_mm256_fmadd_ps(_mm256_set1_ps(((float)(rowE[2] + A[2] * x) + A[2] * middleX) * invArea), dP2.lump, P0.lump));
+					mipSelection mips = select_mip_levels(*tex, level_of_detail(*tex, middle, dPdx, dPdy, perspectiveCorrect), filter);
+
+					sample_mipmapped_avx2(mips, attributes[3], attributes[4], r.lump, g.lump, b.lump);
+					r.lump = _mm256_mul_ps(r.lump, attributes[0]);
+					g.lump = _mm256_mul_ps(g.lump, attributes[1]);
+					b.lump = _mm256_mul_ps(b.lump, attributes[2]);
+				}
+				else {
+					r.lump = attributes[0];
+					g.lump = attributes[1];
+					b.lump = attributes[2];
+				}
+
+				int* pixels = reinterpret_cast<int*>(_frame.colorBufferData) + _frame.width * y + x;
+				_mm256_maskstore_epi32(pixels, _mm256_castps_si256(coverage), pack_colors_avx2<format>(r.lump, g.lump, b.lump));
+			}
+		}
+	}
+
+	if (rejected) {
+		rejectedFragments += rejected;
+	}
+}
+
+/**
+* Turn dirty tile tracking on or off. While it's on, the framebuffer keeps its
+* contents from frame to frame: everything the lines and polygons touch is
+* recorded, clears count only what was drawn since the last one, the other frames in flight catch up on those tiles before they're
+* drawn into, and only tiles which changed are uploaded to each swapchain image.
+*/
+void Engine::set_dirty_tracking(bool enabled) {
+
+	//the presenter reads the tiles while uploading
+	if (pipelined) {
+		frameQueue.wait_idle();
+	}
+
+	if (enabled && !dirtyTracking) {
+		reset_dirty_tiles();
+	}
+
+	dirtyTracking = enabled;
+}
+
+/**
+* Start tracking from scratch: no image holds anything known yet, and every
+* frame but the current one has to catch up with it.
+*/
+void Engine::reset_dirty_tiles() {
+
+	int frameWidth = swapchainFrames[frameNumber].width;
+	int frameHeight = swapchainFrames[frameNumber].height;
+
+	drawnTiles.resize(swapchainFrames.size());
+	for (raster::DirtyTiles& drawn : drawnTiles) {
+		drawn.resize(frameWidth, frameHeight);
+	}
+
+	staleImages.resize(swapchainFrames.size());
+	for (raster::DirtyTiles& stale : staleImages) {
+		stale.resize(frameWidth, frameHeight);
+		stale.mark_all();
+	}
+
+	staleFrames.resize(swapchainFrames.size());
+	for (size_t i = 0; i < staleFrames.size(); ++i) {
+		staleFrames[i].resize(frameWidth, frameHeight);
+		if ((int)i != frameNumber) {
+			staleFrames[i].mark_all();
+		}
+	}
+
+	paintedTiles.resize(frameWidth, frameHeight);
+	clearColorKnown = false;
+}
+
+void Engine::mark_dirty(int x1, int y1, int x2, int y2) {
+
+	if (dirtyTracking) {
+		drawnTiles[frameNumber].mark(x1, y1, x2, y2);
+		paintedTiles.mark(x1, y1, x2, y2);
+	}
+}
+
+void Engine::mark_dirty(const edgeTable& polygon) {
+
+	if (dirtyTracking) {
+		drawnTiles[frameNumber].mark(polygon);
+		paintedTiles.mark(polygon);
+	}
+}
+
+/**
+* Mark what a clear changes. The frame being drawn has caught up with the
+* others, so clearing to the same color as last time only changes the tiles
+* drawn into since then, the rest already hold that color.
+*/
+void Engine::mark_cleared(const unsigned char* color) {
+
+	if (!dirtyTracking) {
+		return;
+	}
+
+	uint32_t packed;
+	memcpy(&packed, color, sizeof(packed));
+
+	if (clearColorKnown && packed == clearColor) {
+		drawnTiles[frameNumber].merge(paintedTiles);
+	}
+	else {
+		drawnTiles[frameNumber].mark_all();
+	}
+
+	paintedTiles.clear();
+	clearColorKnown = true;
+	clearColor = packed;
+}
+
+/**
+* Turn tile binning on or off. While it's on, blended and textured polygons
+* are only stored when drawn, and get rasterized tile by tile across the
+* worker pool once the frame is rendered (or flush_bins is called).
+*/
+void Engine::set_tile_binning(bool enabled) {
+
+	if (!enabled) {
+		flush_bins();
+	}
+	else if (workers == nullptr) {
+		workers = new raster::WorkerPool();
+	}
+
+	tileBinning = enabled;
+}
+
+/**
+* Rasterize everything waiting in the bins. Each polygon's scanline tables
+* are traced in parallel, then each tile is drawn by exactly one thread,
+* polygons in submission order, so the result matches drawing immediately.
+* Lines, flat spans and flat polygons aren't binned, they flush first.
+*/
+void Engine::flush_bins() {
+
+	if (bins.polygons.empty()) {
+		return;
+	}
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	bins.rowStart.resize(bins.rowCount);
+	bins.rowEnd.resize(bins.rowCount);
+
+	workers->run(static_cast<int>(bins.polygons.size()), [this](int i) {
+		if (!bins.polygons[i].halfSpace) {
+			trace_binned_polygon(bins.polygons[i]);
+		}
+	});
+
+	bins.bin_polygons(_frame.width, _frame.height);
+
+	workers->run(bins.tileCountX * bins.tileCountY, [this](int i) {
+		draw_tile(i);
+	});
+
+	bins.clear();
+}
+
+void Engine::trace_binned_polygon(raster::binnedPolygon& polygon) {
+
+	PROFILE_SCOPE(rasterize);
+
+	//offset the tables so they can be indexed by screen row
+	vertex* vertex_start = bins.rowStart.data() + polygon.firstRow - polygon.y_min;
+	vertex* vertex_end = bins.rowEnd.data() + polygon.firstRow - polygon.y_min;
+	vertex* corners = bins.corners.data() + polygon.firstCorner;
+
+	for (int y = polygon.y_min; y <= polygon.y_max; ++y) {
+		vertex_start[y].x = std::numeric_limits<int>::max();
+		vertex_end[y].x = std::numeric_limits<int>::min();
+	}
+
+	//every row an edge crosses lies within the polygon's bounds
+	for (int j = 0; j < polygon.cornerCount; ++j) {
+		interpolate_edge(corners[j], corners[(j + 1) % polygon.cornerCount], vertex_start, vertex_end);
+	}
+}
+
+void Engine::draw_tile(int tile) {
+
+	PROFILE_SCOPE(shade);
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	int x1 = raster::tileSize * (tile % bins.tileCountX);
+	int y1 = raster::tileSize * (tile / bins.tileCountX);
+	int x2 = std::min(_frame.width, x1 + raster::tileSize);
+	int y2 = std::min(_frame.height, y1 + raster::tileSize);
+
+	for (int i : bins.tiles[tile]) {
+
+		raster::binnedPolygon& polygon = bins.polygons[i];
+
+		//the part of the polygon's bounds inside this tile
+		int left = std::max(x1, polygon.x_min);
+		int top = std::max(y1, polygon.y_min);
+		int right = std::min(x2 - 1, polygon.x_max);
+		int bottom = std::min(y2 - 1, polygon.y_max);
+
+		//coarse blocks never straddle tiles, so this thread owns every one it touches
+		if (depthTest && hiZ.occluded(polygon.nearestDepth, left, top, right, bottom)) {
+			++occludedPolygons;
+			continue;
+		}
+
+		if (polygon.halfSpace) {
+			rasterize_halfspace(
+				bins.corners.data() + polygon.firstCorner, polygon.cornerCount,
+				polygon.tex, x1, y1, x2, y2
+			);
+		}
+		else {
+			for (int y = top; y <= bottom; ++y) {
+
+				vertex& start = bins.rowStart[polygon.firstRow + y - polygon.y_min];
+				vertex& end = bins.rowEnd[polygon.firstRow + y - polygon.y_min];
+				if (start.x >= end.x) {
+					continue;
+				}
+
+				if (overdrawCounting) {
+					count_span_overdraw(std::max(start.x, x1), std::min(end.x, x2), y);
+				}
+
+				if (polygon.tex) {
+					draw_horizontal_line_textured(start, end, y, *polygon.tex, polygon.dPdy, x1, x2);
+				}
+				else {
+					draw_horizontal_line_blended(start, end, y, x1, x2);
+				}
+			}
+		}
+
+		if (depthTest) {
+			hiZ.update(_frame.depthBufferData.data(), left, top, right, bottom);
+		}
+	}
+}
+
+/**
+* The swapchain must be recreated upon resize or minimization, among other cases.
+* The old swapchain is handed to the new one, and frames keep their staging memory,
+* command buffers and sync objects, only their images are swapped out. Every frame's
+* fence is waited on, so no transfer into an old image is left running, but the old
+* swapchain may still have images queued for presentation: it's only destroyed once
+* the new one has presented a full cycle of its images.
+*/
+void Engine::recreate_swapchain() {
+
+	width = 0;
+	height = 0;
+	while (width == 0 || height == 0) {
+		glfwGetFramebufferSize(window, &width, &height);
+		glfwWaitEvents();
+	}
+
+	if (pipelined) {
+		frameQueue.wait_idle();
+	}
+
+	std::vector<vk::Fence> inFlight;
+	for (vkUtil::SwapChainFrame& frame : swapchainFrames) {
+		inFlight.push_back(frame.inFlight);
+	}
+	device.waitForFences(inFlight, VK_TRUE, UINT64_MAX);
+
+	vkInit::SwapChainBundle bundle = vkInit::create_swapchain(
+		device, physicalDevice, surface, width, height, policy, swapchain
+	);
+
+	//recreated again before the last one was released, there's no counting on
+	//presents any more, so wait for the present queue to drain instead
+	if (retiredSwapchain) {
+		presentQueue.waitIdle();
+		device.destroySwapchainKHR(retiredSwapchain);
+	}
+	retiredSwapchain = swapchain;
+	retiredPresentsLeft = static_cast<int>(bundle.frames.size());
+
+	swapchain = bundle.swapchain;
+	swapchainFormat = bundle.format;
+	swapchainExtent = bundle.extent;
+	choose_color_conversion_function();
+	fit_to_extent();
+
+	//the image count can change along with the size
+	size_t keptFrames = std::min(swapchainFrames.size(), bundle.frames.size());
+	for (size_t i = keptFrames; i < swapchainFrames.size(); ++i) {
+		device.freeCommandBuffers(commandPool, swapchainFrames[i].commandBuffer);
+		swapchainFrames[i].destroy();
+	}
+	swapchainFrames.resize(keptFrames);
+
+	for (size_t i = 0; i < keptFrames; ++i) {
+		vkUtil::SwapChainFrame& frame = swapchainFrames[i];
+		device.destroyImageView(frame.imageView);
+		frame.image = bundle.frames[i].image;
+		frame.imageView = bundle.frames[i].imageView;
+		frame.resize(swapchainExtent.width, swapchainExtent.height);
+	}
+
+	std::vector<vkUtil::SwapChainFrame> newFrames(bundle.frames.begin() + keptFrames, bundle.frames.end());
+	for (vkUtil::SwapChainFrame& frame : newFrames) {
+		frame.logicalDevice = device;
+		frame.physicalDevice = physicalDevice;
+		frame.width = swapchainExtent.width;
+		frame.height = swapchainExtent.height;
+		frame.imageAvailable = vkInit::make_semaphore(device);
+		frame.renderFinished = vkInit::make_semaphore(device);
+		frame.inFlight = vkInit::make_fence(device);
+		frame.setup();
+	}
+	vkInit::commandBufferInputChunk commandBufferInput = { device, commandPool, newFrames };
+	vkInit::make_frame_command_buffers(commandBufferInput);
+	swapchainFrames.insert(swapchainFrames.end(), newFrames.begin(), newFrames.end());
+
+	maxFramesInFlight = static_cast<int>(swapchainFrames.size());
+	frameNumber = 0;
+	drawStarted.assign(swapchainFrames.size(), std::chrono::steady_clock::now());
+
+	if (dirtyTracking) {
+		reset_dirty_tiles();
+	}
+
+	//the number of frames may have changed
+	if (pipelined) {
+		frameQueue.open(maxFramesInFlight - 1);
+	}
+	swapchainOutdated = false;
+
+}
+
+void Engine::finalize_setup() {
+
+	commandPool = vkInit::make_command_pool(device, physicalDevice, surface);
+
+	vkInit::commandBufferInputChunk commandBufferInput = { device, commandPool, swapchainFrames };
+	mainCommandBuffer = vkInit::make_command_buffer(commandBufferInput);
+	vkInit::make_frame_command_buffers(commandBufferInput);
+
+	make_frame_resources();
+
+}
+
+void Engine::make_frame_resources() {
+
+	for (vkUtil::SwapChainFrame& frame : swapchainFrames) {
+
+		frame.imageAvailable = vkInit::make_semaphore(device);
+		frame.renderFinished = vkInit::make_semaphore(device);
+		frame.inFlight = vkInit::make_fence(device);
+
+		frame.setup();
+	}
+
+	drawStarted.assign(swapchainFrames.size(), std::chrono::steady_clock::now());
+
+}
+
+void Engine::flush_frame(uint32_t imageIndex, uint32_t frameNumber) {
+
+	vk::CommandBuffer& commandBuffer = swapchainFrames[frameNumber].commandBuffer;
+
+	vk::CommandBufferBeginInfo beginInfo = {};
+
+	try {
+		commandBuffer.begin(beginInfo);
+	}
+	catch (vk::SystemError err) {
+		vkLogging::Logger::get_logger()->print("Failed to begin recording command buffer!");
+	}
+
+	vkUtil::SwapChainFrame& frame = swapchainFrames[frameNumber];
+	vk::Image destination = swapchainFrames[imageIndex].image;
+
+	if (dirtyTracking) {
+		//the image needs everything drawn since it was last written to, not just this frame
+		raster::DirtyTiles& drawn = drawnTiles[frameNumber];
+		raster::DirtyTiles& stale = staleImages[imageIndex];
+		stale.merge(drawn);
+		if (stale.full()) {
+			frame.flush(destination);
+		}
+		else {
+			stale.regions(uploadRegions);
+			frame.flush(destination, uploadRegions);
+		}
+
+		for (size_t i = 0; i < staleImages.size(); ++i) {
+			if (i == imageIndex) {
+				staleImages[i].clear();
+			}
+			else {
+				staleImages[i].merge(drawn);
+			}
+		}
+		drawn.clear();
+	}
+	else {
+		frame.flush(destination);
+	}
+
+	try {
+		commandBuffer.end();
+	}
+	catch (vk::SystemError err) {
+		
+		vkLogging::Logger::get_logger()->print("failed to record command buffer!");
+	}
+}
+
+void Engine::render_headless() {
+
+	flush_bins();
+
+	vkUtil::SwapChainFrame& _frame = swapchainFrames[frameNumber];
+
+	//a single frame is always current, only the target's copy can be stale
+	if (dirtyTracking) {
+		raster::DirtyTiles& stale = staleImages[frameNumber];
+		stale.merge(drawnTiles[frameNumber]);
+		stale.regions(uploadRegions);
+		target->present_regions(_frame.colorBufferData, _frame.width, _frame.height, uploadRegions);
+		stale.clear();
+		drawnTiles[frameNumber].clear();
+	}
+	else {
+		target->present(_frame.colorBufferData, _frame.width, _frame.height);
+	}
+
+	frameNumber = (frameNumber + 1) % maxFramesInFlight;
+}
+
+void Engine::render() {
+
+	if (target) {
+		render_headless();
+		return;
+	}
+
+	flush_bins();
+
+	//every other frame will have to catch up on what this one drew
+	if (dirtyTracking) {
+		for (size_t i = 0; i < staleFrames.size(); ++i) {
+			if ((int)i != frameNumber) {
+				staleFrames[i].merge(drawnTiles[frameNumber]);
+			}
+		}
+	}
+
+	//the presenter can't rebuild the swapchain under frames being drawn, so it's done here
+	if (swapchainOutdated) {
+		std::cout << "Recreate" << std::endl;
+		recreate_swapchain();
+		return;
+	}
+
+	if (pipelined) {
+		frameQueue.push(frameNumber);
+	}
+	else if (!present_frame(frameNumber)) {
+		std::cout << "Recreate" << std::endl;
+		recreate_swapchain();
+		return;
+	}
+
+	begin_next_frame();
+}
+
+/**
+* Acquire a swapchain image, then record, submit and present the transfer of
+* a finished frame into it. The frame's fence is only reset once an image has
+* been acquired, so a frame which gets dropped never leaves its fence unsignaled.
+*
+* @param frame	the frame to present
+* @returns		false if the swapchain is out of date and has to be recreated
+*/
+bool Engine::present_frame(int frame) {
+
+	uint32_t imageIndex;
+	try {
+		PROFILE_SCOPE(acquire);
+		vk::ResultValue acquire = device.acquireNextImageKHR(
+			swapchain, UINT64_MAX, 
+			swapchainFrames[frame].imageAvailable, nullptr
+		);
+		imageIndex = acquire.value;
+	}
+	catch (vk::OutOfDateKHRError error) {
+		return false;
+	}
+	catch (vk::IncompatibleDisplayKHRError error) {
+		return false;
+	}
+	catch (vk::SystemError error) {
+		std::cout << "Failed to acquire swapchain image!" << std::endl;
+		return true;
+	}
+
+	device.resetFences(1, &(swapchainFrames[frame].inFlight));
+
+	vk::CommandBuffer& commandBuffer = swapchainFrames[frame].commandBuffer;
+
+	commandBuffer.reset();
+
+	flush_frame(imageIndex, frame);
+
+	vk::SubmitInfo submitInfo = {};
+
+	vk::Semaphore waitSemaphores[] = { swapchainFrames[frame].imageAvailable };
+	vk::PipelineStageFlags waitStages[] = { vk::PipelineStageFlagBits::eColorAttachmentOutput };
+	submitInfo.waitSemaphoreCount = 1;
+	submitInfo.pWaitSemaphores = waitSemaphores;
+	submitInfo.pWaitDstStageMask = waitStages;
+
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &commandBuffer;
+
+	vk::Semaphore signalSemaphores[] = { swapchainFrames[frame].renderFinished };
+	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.pSignalSemaphores = signalSemaphores;
+
+	try {
+		graphicsQueue.submit(submitInfo, swapchainFrames[frame].inFlight);
+	}
+	catch (vk::SystemError err) {
+		vkLogging::Logger::get_logger()->print("failed to submit draw command buffer!");
+	}
+
+	vk::PresentInfoKHR presentInfo = {};
+	presentInfo.waitSemaphoreCount = 1;
+	presentInfo.pWaitSemaphores = signalSemaphores;
+
+	vk::SwapchainKHR swapChains[] = { swapchain };
+	presentInfo.swapchainCount = 1;
+	presentInfo.pSwapchains = swapChains;
+
+	presentInfo.pImageIndices = &imageIndex;
+
+	vk::Result present;
+
+	try {
+		PROFILE_SCOPE(present);
+		present = presentQueue.presentKHR(presentInfo);
+	}
+	catch (vk::OutOfDateKHRError error) {
+		present = vk::Result::eErrorOutOfDateKHR;
+	}
+
+	bool presented = present == vk::Result::eSuccess || present == vk::Result::eSuboptimalKHR;
+	if (presented && retiredPresentsLeft > 0) {
+		--retiredPresentsLeft;
+	}
+
+	//from the frame starting to be drawn, through any queueing, until presentation returns
+	float latency = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - drawStarted[frame]).count();
+	{
+		std::lock_guard<std::mutex> guard(latencyLock);
+		const size_t sampleCount = 240;
+		if (latencySamples.size() < sampleCount) {
+			latencySamples.push_back(latency);
+		}
+		else {
+			latencySamples[nextLatencySample] = latency;
+			nextLatencySample = (nextLatencySample + 1) % sampleCount;
+		}
+	}
+
+	return present != vk::Result::eErrorOutOfDateKHR && present != vk::Result::eSuboptimalKHR;
+}
+
+/**
+* The mapping from normalized device coordinates to the pixels of the frames
+* being drawn. It follows the swapchain, so callers should fetch it every frame.
+*/
+viewportTransform Engine::get_viewport() {
+	return viewport;
+}
+
+/**
+* Summarize the latency of the last few seconds' worth of presented frames
+* (the last 240 of them), under the policy the engine was made with.
+*/
+frameLatencyStats Engine::get_frame_latency_stats() {
+
+	std::vector<float> samples;
+	{
+		std::lock_guard<std::mutex> guard(latencyLock);
+		samples = latencySamples;
+	}
+
+	frameLatencyStats stats = { policy, static_cast<int>(samples.size()), 0.0f, 0.0f, 0.0f };
+	if (samples.empty()) {
+		return stats;
+	}
+
+	std::sort(samples.begin(), samples.end());
+	for (float sample : samples) {
+		stats.mean += sample;
+	}
+	stats.mean /= samples.size();
+	stats.median = samples[samples.size() / 2];
+	stats.p99 = samples[(samples.size() * 99) / 100];
+
+	return stats;
+}
+
+/**
+* Move on to the next frame, waiting until it's safe to draw into.
+*/
+void Engine::begin_next_frame() {
+
+	release_retired_swapchain();
+
+	frameNumber = (frameNumber + 1) % maxFramesInFlight;
+
+	//the presenter may not have submitted it yet
+	if (pipelined) {
+		frameQueue.wait_for(frameNumber);
+	}
+
+	//the next frame is drawn straight into its staging memory, so its last
+	//transfer out of that memory has to be finished before drawing starts
+	{
+		PROFILE_SCOPE(fenceWait);
+		device.waitForFences(1, &(swapchainFrames[frameNumber].inFlight), VK_TRUE, UINT64_MAX);
+	}
+	drawStarted[frameNumber] = std::chrono::steady_clock::now();
+
+	if (dirtyTracking) {
+		//catch its pixels up with what the other frames drew since, the frame
+		//just rendered is always current
+		int previous = (frameNumber + maxFramesInFlight - 1) % maxFramesInFlight;
+		staleFrames[frameNumber].regions(catchUpRegions);
+		swapchainFrames[frameNumber].copy_regions(swapchainFrames[previous], catchUpRegions);
+		staleFrames[frameNumber].clear();
+	}
+}
+
+/**
+* The presenter thread's loop: present finished frames in the order they were
+* drawn. Once the swapchain is out of date, frames are dropped until the
+* drawing thread has recreated it.
+*/
+void Engine::present_frames() {
+
+	int frame;
+	while (frameQueue.pop(frame)) {
+
+		if (!swapchainOutdated && !present_frame(frame)) {
+			swapchainOutdated = true;
+		}
+
+		frameQueue.finish(frame);
+	}
+}
+
+/**
+* Turn pipelined presentation on or off. While it's on, render only hands the
+* finished frame to a presenter thread, which acquires, submits and presents
+* it while the next frame is drawn, so drawing never waits on the swapchain.
+* At most all but one of the frames in flight wait to be presented at once.
+* Headless targets are always presented inline.
+*/
+void Engine::set_pipelined(bool enabled) {
+
+	if (target || enabled == pipelined) {
+		return;
+	}
+
+	if (enabled) {
+		frameQueue.open(maxFramesInFlight - 1);
+		presenter = std::thread(&Engine::present_frames, this);
+	}
+	else {
+		frameQueue.close();
+		presenter.join();
+	}
+
+	pipelined = enabled;
+}
+
+/**
+* Destroy the swapchain replaced by the last recreation, once the new one has
+* presented as many images as it has. Presents go through the queue in order,
+* so everything queued on the old swapchain has been presented by then.
+*/
+void Engine::release_retired_swapchain() {
+
+	if (retiredSwapchain && retiredPresentsLeft <= 0) {
+		device.destroySwapchainKHR(retiredSwapchain);
+		retiredSwapchain = nullptr;
+	}
+}
+
+/**
+* Free the memory associated with the swapchain objects
+*/
+void Engine::cleanup_swapchain() {
+
+	for (vkUtil::SwapChainFrame& frame : swapchainFrames) {
+		frame.destroy();
+	}
+	if (retiredSwapchain) {
+		device.destroySwapchainKHR(retiredSwapchain);
+	}
+	device.destroySwapchainKHR(swapchain);
+
+}
+
+Engine::~Engine() {
+
+	set_pipelined(false);
+
+	delete workers;
+
+	if (target) {
+		for (vkUtil::SwapChainFrame& frame : swapchainFrames) {
+			frame.free_color_buffer();
+		}
+		vkLogging::Logger::get_logger()->print("Goodbye see you!");
+		return;
+	}
+
+	device.waitIdle();
+
+	vkLogging::Logger::get_logger()->print("Goodbye see you!");
+
+	device.destroyCommandPool(commandPool);
+
+	cleanup_swapchain();
+
+	device.destroy();
+
+	instance.destroySurfaceKHR(surface);
+	if (vkLogging::Logger::get_logger()->get_debug_mode()) {
+		instance.destroyDebugUtilsMessengerEXT(debugMessenger, nullptr, dldi);
+	}
+	/*
+	* from vulkan_funcs.hpp:
+	* 
+	* void Instance::destroy( Optional<const VULKAN_HPP_NAMESPACE::AllocationCallbacks> allocator = nullptr,
+                                            Dispatch const & d = ::vk::getDispatchLoaderStatic())
+	*/
+	instance.destroy();
+
+	//terminate glfw
+	glfwTerminate();
 }
\ No newline at end of file
@@ -1,110 +1,305 @@
-#pragma once
-#include "../config.h"
-#include "vkUtil/frame.h"
-#include "vkImage/image.h"
-#include "../linear_algebros.h"
-
-class Engine {
-
-public:
-
-	Engine(int width, int height, GLFWwindow* window);
-
-	~Engine();
-
-	void clear_screen(float r, float g, float b);
-
-	void clear_screen_avx2(float r, float g, float b);
-
-	void draw_horizontal_line(float r, float g, float b, int x1, int x2, int y);
-
-	void draw_horizontal_line_avx2(float r, float g, float b, int x1, int x2, int y);
-
-	void draw_vertical_line(float r, float g, float b, int x, int y1, int y2);
-
-	void draw_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2);
-
-	void draw_shallow_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2);
-
-	void draw_steep_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2);
-
-	void draw_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2);
-
-	void draw_shallow_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2);
-
-	void draw_steep_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2);
-
-	void draw_polygon_flat(float r, float g, float b, edgeTable polygon);
-
-	void trace_shallow_edge(int x1, int y1, int x2, int y2, int* x_start, int* x_end);
-
-	void trace_steep_edge(int x1, int y1, int x2, int y2, int* x_start, int* x_end);
-
-	void draw_polygon_blended(edgeTable polygon);
-
-	void interpolate_shallow_edge(vertex v1, vertex v2, vertex* vertex_start, vertex* vertex_end);
-
-	void interpolate_steep_edge(vertex v1, vertex v2, vertex* vertex_start, vertex* vertex_end);
-
-	void draw_horizontal_line_blended(vertex v1, vertex v2, int y);
-
-	texture convert_texture(stbi_uc* textureData, int width, int height);
-
-	void draw_polygon_textured(edgeTable& polygon, texture& tex);
-
-	void draw_horizontal_line_textured(vertex v1, vertex v2, int y, texture& tex);
-
-	void render();
-
-private:
-
-	//glfw-related variables
-	int width;
-	int height;
-	GLFWwindow* window;
-
-	//instance-related variables
-	vk::Instance instance{ nullptr };
-	vk::DebugUtilsMessengerEXT debugMessenger{ nullptr };
-	vk::DispatchLoaderDynamic dldi;
-	vk::SurfaceKHR surface;
-
-	//device-related variables
-	vk::PhysicalDevice physicalDevice{ nullptr };
-	vk::Device device{ nullptr };
-	vk::Queue graphicsQueue{ nullptr };
-	vk::Queue presentQueue{ nullptr };
-	vk::SwapchainKHR swapchain{ nullptr };
-	std::vector<vkUtil::SwapChainFrame> swapchainFrames;
-	vk::Format swapchainFormat;
-	vk::Extent2D swapchainExtent;
-
-	//Command-related variables
-	vk::CommandPool commandPool;
-	vk::CommandBuffer mainCommandBuffer;
-
-	//Synchronization objects
-	int maxFramesInFlight, frameNumber;
-
-	//Color conversion function
-	unsigned char* (*convert_color)(float, float, float);
-
-	//instance setup
-	void make_instance();
-
-	//device setup
-	void make_device();
-	void make_swapchain();
-	void recreate_swapchain();
-
-	//final setup steps
-	void finalize_setup();
-	void make_frame_resources();
-
-	void flush_frame(uint32_t imageIndex, uint32_t frameNumber);
-
-	void choose_color_conversion_function();
-
-	//Cleanup functions
-	void cleanup_swapchain();
+#pragma once
+#include "../config.h"
+#include "vkUtil/frame.h"
+#include "vkImage/image.h"
+#include "renderTarget/render_target.h"
+#include "raster/worker_pool.h"
+#include "raster/tile_bins.h"
+#include "raster/hi_z.h"
+#include "raster/dirty_tiles.h"
+#include "vkUtil/frame_queue.h"
+#include "vkInit/present_policy.h"
+#include <chrono>
+#include "../linear_algebros.h"
+
+/**
+	How textured polygons interpolate their attributes across the screen
+*/
+enum class perspectiveMode {
+	//linear in screen space, cheapest but textures swim
+	affine,
+	//divide by the interpolated 1/w at every pixel
+	exact,
+	//correct every 8 or 16 pixels, linear in between
+	subdivide8,
+	subdivide16
+};
+
+/**
+	How long recent frames took from starting to be drawn until they were
+	presented, in milliseconds
+*/
+struct frameLatencyStats {
+	presentPolicy policy;
+	//how many frames the figures cover
+	int frameCount;
+	float mean, median, p99;
+};
+
+class Engine {
+
+public:
+
+	Engine(int width, int height, GLFWwindow* window, presentPolicy policy = presentPolicy::maxThroughput);
+
+	Engine(int width, int height, renderTarget::RenderTarget* target);
+
+	~Engine();
+
+	void clear_screen(float r, float g, float b);
+
+	void clear_screen_avx2(float r, float g, float b);
+
+	void draw_horizontal_line(float r, float g, float b, int x1, int x2, int y);
+
+	void draw_horizontal_line_avx2(float r, float g, float b, int x1, int x2, int y);
+
+	void draw_vertical_line(float r, float g, float b, int x, int y1, int y2);
+
+	void draw_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2);
+
+	void draw_shallow_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2);
+
+	void draw_steep_line_naive(float r, float g, float b, int x1, int y1, int x2, int y2);
+
+	void draw_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2);
+
+	void draw_shallow_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2);
+
+	void draw_steep_line_bresenham(float r, float g, float b, int x1, int y1, int x2, int y2);
+
+	void draw_polygon_flat(float r, float g, float b, edgeTable polygon);
+
+	void trace_edge(int x1, int y1, int x2, int y2, int* x_start, int* x_end);
+
+	void draw_polygon_blended(edgeTable polygon);
+
+	void interpolate_edge(vertex v1, vertex v2, vertex* vertex_start, vertex* vertex_end);
+
+	void draw_horizontal_line_blended(vertex v1, vertex v2, int y);
+
+	void draw_horizontal_line_blended(vertex v1, vertex v2, int y, int clip_x1, int clip_x2);
+
+	texture convert_texture(stbi_uc* textureData, int width, int height, textureLayout layout);
+
+	void free_texture(texture& tex);
+
+	void draw_polygon_textured(edgeTable& polygon, texture& tex);
+
+	void draw_horizontal_line_textured(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy);
+
+	void draw_horizontal_line_textured(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy, int clip_x1, int clip_x2);
+
+	void set_simd_spans(bool enabled);
+
+	void set_perspective_mode(perspectiveMode mode);
+
+	void set_texture_filter(textureFilter filter);
+
+	void set_depth_test(bool enabled);
+
+	uint64_t get_rejected_fragment_count();
+
+	bool is_occluded(vec4* clipVertices, int vertexCount);
+
+	uint64_t get_occluded_polygon_count();
+
+	void set_overdraw_counting(bool enabled);
+
+	uint64_t get_overdraw_count();
+
+	void draw_polygon_blended_halfspace(edgeTable& polygon);
+
+	void draw_polygon_textured_halfspace(edgeTable& polygon, texture& tex);
+
+	void rasterize_halfspace(vertex* corners, int cornerCount, texture* tex,
+		int clip_x1, int clip_y1, int clip_x2, int clip_y2);
+
+	void set_tile_binning(bool enabled);
+
+	void set_dirty_tracking(bool enabled);
+
+	void set_pipelined(bool enabled);
+
+	frameLatencyStats get_frame_latency_stats();
+
+	viewportTransform get_viewport();
+
+	void flush_bins();
+
+	void render();
+
+private:
+
+	//glfw-related variables
+	int width;
+	int height;
+	GLFWwindow* window;
+
+	//headless target, if set the engine never touches vulkan
+	renderTarget::RenderTarget* target{ nullptr };
+
+	//instance-related variables
+	vk::Instance instance{ nullptr };
+	vk::DebugUtilsMessengerEXT debugMessenger{ nullptr };
+	vk::DispatchLoaderDynamic dldi;
+	vk::SurfaceKHR surface;
+
+	//device-related variables
+	vk::PhysicalDevice physicalDevice{ nullptr };
+	vk::Device device{ nullptr };
+	vk::Queue graphicsQueue{ nullptr };
+	vk::Queue presentQueue{ nullptr };
+	vk::SwapchainKHR swapchain{ nullptr };
+	//replaced by the last recreation, kept until the new one has presented enough
+	//images that none of the old ones can still be waiting to be shown
+	vk::SwapchainKHR retiredSwapchain{ nullptr };
+	std::atomic<int> retiredPresentsLeft{ 0 };
+	std::vector<vkUtil::SwapChainFrame> swapchainFrames;
+	vk::Format swapchainFormat;
+	vk::Extent2D swapchainExtent;
+
+	//Mapping from normalized device coordinates to the swapchain's pixels
+	viewportTransform viewport;
+
+	//Command-related variables
+	vk::CommandPool commandPool;
+	vk::CommandBuffer mainCommandBuffer;
+
+	//Synchronization objects
+	int maxFramesInFlight, frameNumber;
+
+	//Tile binned rasterization
+	bool tileBinning{ false };
+	raster::WorkerPool* workers{ nullptr };
+	raster::TileBins bins;
+
+	//Textured attribute interpolation
+	perspectiveMode perspective{ perspectiveMode::affine };
+
+	//Textured spans, scalar or eight fragments at a time
+	bool simdSpans{ false };
+
+	//Filtering between mip levels
+	textureFilter filter{ textureFilter::bilinear };
+
+	//Depth testing, fragments failing it are counted between clears
+	bool depthTest{ false };
+	std::atomic<uint64_t> rejectedFragments{ 0 };
+
+	//Overdraw counting: which pixels have been rasterized since the last clear,
+	//and how many fragments landed on a pixel which already had one
+	bool overdrawCounting{ false };
+	std::vector<uint8_t> covered;
+	std::atomic<uint64_t> overdrawnFragments{ 0 };
+
+	//Coarse depth, for throwing away whole polygons
+	raster::HiZ hiZ;
+	std::atomic<uint64_t> occludedPolygons{ 0 };
+
+	//Dirty tile tracking: tiles drawn into each frame, changed since each
+	//image was written and since each frame was last drawn into
+	bool dirtyTracking{ false };
+	std::vector<raster::DirtyTiles> drawnTiles, staleImages, staleFrames;
+	std::vector<vk::Rect2D> uploadRegions, catchUpRegions;
+	//tiles drawn into since the last clear, and the color it cleared to
+	raster::DirtyTiles paintedTiles;
+	bool clearColorKnown{ false };
+	uint32_t clearColor{ 0 };
+
+	//Pipelined presentation, finished frames wait in the queue for the presenter
+	bool pipelined{ false };
+	std::thread presenter;
+	vkUtil::FrameQueue frameQueue;
+	std::atomic<bool> swapchainOutdated{ false };
+
+	//Presentation policy, and the latency of the frames it's presented
+	presentPolicy policy{ presentPolicy::maxThroughput };
+	std::vector<std::chrono::steady_clock::time_point> drawStarted;
+	std::mutex latencyLock;
+	std::vector<float> latencySamples;
+	int nextLatencySample{ 0 };
+
+	//Scanline tables, a start and end per frame row, reused by every polygon drawn
+	std::vector<int> scanlineStartX, scanlineEndX;
+	std::vector<vertex> scanlineStart, scanlineEnd;
+
+	//Snapped corners of the polygon being drawn, big enough for any clipped polygon
+	std::vector<vertex> snappedCorners = std::vector<vertex>(maxClipVertices);
+
+	//Color conversion function
+	unsigned char* (*convert_color)(float, float, float);
+
+	//Per pixel loops, specialized for the swapchain's format
+	void (Engine::*blendedSpan)(vertex, vertex, int, int, int) { nullptr };
+	void (Engine::*texturedSpan)(vertex, vertex, int, texture&, const payload&, int, int) { nullptr };
+	void (Engine::*halfspaceBlocks)(vertex*, int, texture*, int, int, int, int) { nullptr };
+
+	//instance setup
+	void make_instance();
+
+	//device setup
+	void make_device();
+	void make_swapchain();
+	void recreate_swapchain();
+	void release_retired_swapchain();
+	void fit_to_extent();
+
+	//final setup steps
+	void finalize_setup();
+	void make_frame_resources();
+
+	//headless setup
+	void make_headless_frames();
+
+	void flush_frame(uint32_t imageIndex, uint32_t frameNumber);
+
+	bool present_frame(int frame);
+
+	void begin_next_frame();
+
+	void present_frames();
+
+	void render_headless();
+
+	void choose_color_conversion_function();
+
+	template<vk::Format format>
+	void choose_span_loops();
+
+	template<vk::Format format>
+	void shade_blended_span(vertex v1, vertex v2, int y, int clip_x1, int clip_x2);
+
+	template<vk::Format format>
+	void shade_textured_span(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy, int clip_x1, int clip_x2);
+
+	template<vk::Format format>
+	void draw_horizontal_line_textured_perspective(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy, int clip_x1, int clip_x2);
+
+	template<vk::Format format>
+	void draw_horizontal_line_textured_avx2(vertex v1, vertex v2, int y, texture& tex, const payload& dPdy, int clip_x1, int clip_x2);
+
+	template<vk::Format format>
+	void shade_halfspace(vertex* corners, int cornerCount, texture* tex,
+		int clip_x1, int clip_y1, int clip_x2, int clip_y2);
+
+	//Dirty tile tracking
+	void reset_dirty_tiles();
+	void mark_dirty(int x1, int y1, int x2, int y2);
+	void mark_dirty(const edgeTable& polygon);
+	void mark_cleared(const unsigned char* color);
+
+	//Overdraw counting
+	void count_span_overdraw(int x1, int x2, int y);
+	void count_block_overdraw(int x, int y, int mask);
+
+	//Fixed point corners for immediate drawing
+	vertex* snap_corners(const edgeTable& polygon, bool perspectiveCorrect);
+
+	//Tile binning
+	void trace_binned_polygon(raster::binnedPolygon& polygon);
+	void draw_tile(int tile);
+
+	//Cleanup functions
+	void cleanup_swapchain();
 };
\ No newline at end of file
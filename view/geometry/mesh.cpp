@@ -0,0 +1,77 @@
+#include "mesh.h"
+#include "../../control/profiler.h"
+
+int geometry::Mesh::add_vertex(vec4 position, payload attribute) {
+
+	x.push_back(position.data[0]);
+	y.push_back(position.data[1]);
+	z.push_back(position.data[2]);
+	w.push_back(position.data[3]);
+	attributes.push_back(attribute);
+
+	return vertex_count() - 1;
+}
+
+void geometry::Mesh::add_polygon(const int* corners) {
+
+	indices.insert(indices.end(), corners, corners + cornersPerPolygon);
+}
+
+int geometry::Mesh::vertex_count() const {
+
+	return static_cast<int>(x.size());
+}
+
+int geometry::Mesh::polygon_count() const {
+
+	return static_cast<int>(indices.size()) / cornersPerPolygon;
+}
+
+const int* geometry::Mesh::polygon(int i) const {
+
+	return indices.data() + cornersPerPolygon * i;
+}
+
+vertexStream geometry::Mesh::positions() {
+
+	return { x.data(), y.data(), z.data(), w.data(), vertex_count() };
+}
+
+void geometry::TransformCache::transform(Mesh& mesh, const mat4* modelView, const mat4* projection) {
+
+	vertexStream positions = mesh.positions();
+	transform(&positions, modelView, projection);
+}
+
+void geometry::TransformCache::transform(const vertexStream* positions, const mat4* modelView, const mat4* projection) {
+
+	PROFILE_SCOPE(transform);
+
+	size_t count = positions->count;
+	if (viewX.size() < count) {
+		for (std::vector<float>* stream : { &viewX, &viewY, &viewZ, &viewW, &clipX, &clipY, &clipZ, &clipW }) {
+			stream->resize(count);
+		}
+	}
+
+	vertexStream view = { viewX.data(), viewY.data(), viewZ.data(), viewW.data(), positions->count };
+	vertexStream clip = { clipX.data(), clipY.data(), clipZ.data(), clipW.data(), positions->count };
+
+	//view space positions are still needed for backface culling and lighting
+	linalgTransformVertexStream(modelView, positions, &view);
+	linalgTransformVertexStream(projection, &view, &clip);
+}
+
+vec4 geometry::TransformCache::view_position(int i) const {
+
+	vec4 position;
+	position.vector = _mm_setr_ps(viewX[i], viewY[i], viewZ[i], viewW[i]);
+	return position;
+}
+
+vec4 geometry::TransformCache::clip_position(int i) const {
+
+	vec4 position;
+	position.vector = _mm_setr_ps(clipX[i], clipY[i], clipZ[i], clipW[i]);
+	return position;
+}
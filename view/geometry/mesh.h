@@ -0,0 +1,100 @@
+#pragma once
+#include "../../config.h"
+#include "../../linear_algebros.h"
+
+namespace geometry {
+
+	/**
+		An indexed mesh of polygons which all have the same number of corners
+		(3 for triangles, 4 for quads). Positions are kept as a structure of
+		arrays so they can be handed straight to the batch transform.
+	*/
+	struct Mesh {
+
+		std::vector<float> x, y, z, w;
+		std::vector<payload> attributes;
+		std::vector<int> indices;
+		int cornersPerPolygon{ 4 };
+
+		/**
+			Add a vertex to the mesh.
+
+			\param position the vertex's position, in model space
+			\param attribute the vertex's attributes
+			\returns the new vertex's index
+		*/
+		int add_vertex(vec4 position, payload attribute);
+
+		/**
+			Add a polygon to the mesh.
+
+			\param corners the indices of the polygon's cornersPerPolygon vertices
+		*/
+		void add_polygon(const int* corners);
+
+		/**
+			\returns the number of unique vertices in the mesh
+		*/
+		int vertex_count() const;
+
+		/**
+			\returns the number of polygons in the mesh
+		*/
+		int polygon_count() const;
+
+		/**
+			\param i the index of a polygon
+			\returns the indices of the polygon's corners
+		*/
+		const int* polygon(int i) const;
+
+		/**
+			\returns a stream over the mesh's positions
+		*/
+		vertexStream positions();
+	};
+
+	/**
+		Post transform vertex cache, indexed by vertex id. Every unique vertex of
+		a mesh is transformed and projected exactly once per frame (in batches),
+		then looked up by each polygon that shares it.
+	*/
+	class TransformCache {
+
+	public:
+
+		std::vector<float> viewX, viewY, viewZ, viewW;
+		std::vector<float> clipX, clipY, clipZ, clipW;
+
+		/**
+			Transform every vertex of a mesh. The cache only ever grows,
+			so a mesh of the same size reuses last frame's storage.
+
+			\param mesh the mesh to transform
+			\param modelView takes the mesh's vertices to view space
+			\param projection takes view space to clip space
+		*/
+		void transform(Mesh& mesh, const mat4* modelView, const mat4* projection);
+
+		/**
+			Transform every vertex of a stream, such as a mapped mesh file's positions.
+
+			\param positions the vertices to transform
+			\param modelView takes the vertices to view space
+			\param projection takes view space to clip space
+		*/
+		void transform(const vertexStream* positions, const mat4* modelView, const mat4* projection);
+
+		/**
+			\param i the index of a vertex
+			\returns the vertex's position in view space
+		*/
+		vec4 view_position(int i) const;
+
+		/**
+			\param i the index of a vertex
+			\returns the vertex's position in clip space
+		*/
+		vec4 clip_position(int i) const;
+	};
+}
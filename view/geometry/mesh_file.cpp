@@ -0,0 +1,351 @@
+#include "mesh_file.h"
+#include "../../control/logging.h"
+#include <unordered_map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+	const char meshFileMagic[4] = { 'S', 'P', 'M', 'F' };
+	const uint32_t meshFileVersion = 1;
+
+	uint64_t align_offset(uint64_t offset) {
+		return (offset + geometry::meshFileAlignment - 1) & ~(uint64_t)(geometry::meshFileAlignment - 1);
+	}
+
+	/**
+		Read one corner of an OBJ face ("v", "v/vt", "v//vn" or "v/vt/vn").
+		Negative indices count back from the end, the results are zero based (-1 if absent).
+	*/
+	const char* parse_corner(const char* cursor, int positionCount, int uvCount, int& position, int& uv) {
+
+		char* end;
+		long index = strtol(cursor, &end, 10);
+		position = (index < 0) ? positionCount + (int)index : (int)index - 1;
+		uv = -1;
+		cursor = end;
+
+		if (*cursor == '/') {
+			++cursor;
+			if (*cursor != '/') {
+				index = strtol(cursor, &end, 10);
+				if (end != cursor) {
+					uv = (index < 0) ? uvCount + (int)index : (int)index - 1;
+				}
+				cursor = end;
+			}
+			if (*cursor == '/') {
+				//normals aren't used
+				strtol(cursor + 1, &end, 10);
+				cursor = end;
+			}
+		}
+
+		return cursor;
+	}
+}
+
+bool geometry::convert_obj(const char* objFilename, const char* meshFilename) {
+
+	std::stringstream message;
+
+	FILE* objFile = fopen(objFilename, "rb");
+	if (!objFile) {
+		message << "Couldn't open \"" << objFilename << "\" for reading.";
+		vkLogging::Logger::get_logger()->print(message.str());
+		return false;
+	}
+	//read in chunks rather than sized with ftell, whose long is 32 bits on windows
+	std::string text;
+	char chunk[1 << 16];
+	size_t bytesRead;
+	while ((bytesRead = fread(chunk, 1, sizeof(chunk), objFile)) > 0) {
+		text.append(chunk, bytesRead);
+	}
+	bool readFailed = ferror(objFile) != 0;
+	fclose(objFile);
+	if (readFailed) {
+		message << "Failed reading \"" << objFilename << "\".";
+		vkLogging::Logger::get_logger()->print(message.str());
+		return false;
+	}
+
+	std::vector<vec4> positions;
+	std::vector<float> uvs;
+
+	std::vector<float> x, y, z, w;
+	std::vector<payload> attributes;
+	std::vector<int> indices;
+	//(position, texture coordinate) pairs already made into vertices
+	std::unordered_map<uint64_t, int> vertexIds;
+	std::vector<int> face;
+
+	const char* cursor = text.c_str();
+	while (*cursor) {
+
+		const char* lineEnd = strchr(cursor, '\n');
+		if (!lineEnd) {
+			lineEnd = cursor + strlen(cursor);
+		}
+		while (*cursor == ' ' || *cursor == '\t') {
+			++cursor;
+		}
+
+		if (cursor[0] == 'v' && (cursor[1] == ' ' || cursor[1] == '\t')) {
+			char* end;
+			vec4 position;
+			position.data[0] = strtof(cursor + 2, &end);
+			position.data[1] = strtof(end, &end);
+			position.data[2] = strtof(end, &end);
+			position.data[3] = 1.0f;
+			positions.push_back(position);
+		}
+		else if (cursor[0] == 'v' && cursor[1] == 't') {
+			char* end;
+			float u = strtof(cursor + 2, &end);
+			float v = strtof(end, &end);
+			uvs.push_back(u);
+			uvs.push_back(1.0f - v);
+		}
+		else if (cursor[0] == 'f' && (cursor[1] == ' ' || cursor[1] == '\t')) {
+
+			face.clear();
+			cursor += 2;
+			while (cursor < lineEnd) {
+				while (cursor < lineEnd && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+					++cursor;
+				}
+				if (cursor >= lineEnd) {
+					break;
+				}
+
+				int position, uv;
+				const char* next = parse_corner(cursor, (int)positions.size(), (int)uvs.size() / 2, position, uv);
+				if (next == cursor || position < 0 || position >= (int)positions.size() || uv >= (int)uvs.size() / 2) {
+					message << "Bad face in \"" << objFilename << "\", skipping it.";
+					vkLogging::Logger::get_logger()->print(message.str());
+					message.str("");
+					face.clear();
+					break;
+				}
+				cursor = next;
+
+				uint64_t key = ((uint64_t)(uint32_t)position << 32) | (uint32_t)uv;
+				auto found = vertexIds.find(key);
+				if (found == vertexIds.end()) {
+					found = vertexIds.emplace(key, (int)x.size()).first;
+					x.push_back(positions[position].data[0]);
+					y.push_back(positions[position].data[1]);
+					z.push_back(positions[position].data[2]);
+					w.push_back(1.0f);
+					payload attribute;
+					attribute.lump = _mm256_setr_ps(1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+					if (uv >= 0) {
+						attribute.data[3] = uvs[2 * uv];
+						attribute.data[4] = uvs[2 * uv + 1];
+					}
+					attributes.push_back(attribute);
+				}
+				face.push_back(found->second);
+			}
+
+			//triangle fan
+			for (size_t i = 2; i < face.size(); ++i) {
+				indices.push_back(face[0]);
+				indices.push_back(face[i - 1]);
+				indices.push_back(face[i]);
+			}
+		}
+
+		cursor = (*lineEnd) ? lineEnd + 1 : lineEnd;
+	}
+
+	MeshFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, meshFileMagic, sizeof(meshFileMagic));
+	header.version = meshFileVersion;
+	header.vertexCount = (int32_t)x.size();
+	header.polygonCount = (int32_t)(indices.size() / 3);
+	header.cornersPerPolygon = 3;
+
+	uint64_t streamSize = sizeof(float) * x.size();
+	header.x = align_offset(sizeof(MeshFileHeader));
+	header.y = align_offset(header.x + streamSize);
+	header.z = align_offset(header.y + streamSize);
+	header.w = align_offset(header.z + streamSize);
+	header.attributes = align_offset(header.w + streamSize);
+	header.indices = align_offset(header.attributes + sizeof(payload) * attributes.size());
+	uint64_t fileSize = header.indices + sizeof(int) * indices.size();
+
+	FILE* meshFile = fopen(meshFilename, "wb");
+	if (!meshFile) {
+		message << "Couldn't open \"" << meshFilename << "\" for writing.";
+		vkLogging::Logger::get_logger()->print(message.str());
+		return false;
+	}
+
+	//write each array at its offset, zero filling the gaps in between
+	std::vector<char> zeros(meshFileAlignment, 0);
+	uint64_t written = 0;
+	bool ok = true;
+	auto write_at = [&](uint64_t offset, const void* data, size_t bytes) {
+		ok = ok && fwrite(zeros.data(), 1, (size_t)(offset - written), meshFile) == offset - written;
+		ok = ok && fwrite(data, 1, bytes, meshFile) == bytes;
+		written = offset + bytes;
+	};
+	write_at(0, &header, sizeof(header));
+	write_at(header.x, x.data(), streamSize);
+	write_at(header.y, y.data(), streamSize);
+	write_at(header.z, z.data(), streamSize);
+	write_at(header.w, w.data(), streamSize);
+	write_at(header.attributes, attributes.data(), sizeof(payload) * attributes.size());
+	write_at(header.indices, indices.data(), sizeof(int) * indices.size());
+	ok = (fclose(meshFile) == 0) && ok && written == fileSize;
+
+	if (!ok) {
+		message << "Failed writing \"" << meshFilename << "\".";
+	}
+	else {
+		message << "Converted \"" << objFilename << "\": " << header.vertexCount << " vertices, " << header.polygonCount << " triangles.";
+	}
+	vkLogging::Logger::get_logger()->print(message.str());
+
+	return ok;
+}
+
+geometry::MappedMesh::~MappedMesh() {
+	close();
+}
+
+bool geometry::MappedMesh::open(const char* filename) {
+
+	close();
+
+	std::stringstream message;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		message << "Couldn't open \"" << filename << "\".";
+		vkLogging::Logger::get_logger()->print(message.str());
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	GetFileSizeEx(file, &fileSize);
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	//the view keeps the mapping alive by itself
+	if (mapping) {
+		view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+	}
+	CloseHandle(file);
+	size = (size_t)fileSize.QuadPart;
+#else
+	int file = ::open(filename, O_RDONLY);
+	if (file < 0) {
+		message << "Couldn't open \"" << filename << "\".";
+		vkLogging::Logger::get_logger()->print(message.str());
+		return false;
+	}
+	struct stat status;
+	if (fstat(file, &status) == 0 && status.st_size > 0) {
+		size = (size_t)status.st_size;
+		view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (view == MAP_FAILED) {
+			view = nullptr;
+		}
+	}
+	::close(file);
+#endif
+
+	if (!view) {
+		message << "Couldn't map \"" << filename << "\".";
+		vkLogging::Logger::get_logger()->print(message.str());
+		size = 0;
+		return false;
+	}
+
+	const char* base = static_cast<const char*>(view);
+	MeshFileHeader header;
+	bool valid = size >= sizeof(header);
+	if (valid) {
+		memcpy(&header, base, sizeof(header));
+		uint64_t streamSize = sizeof(float) * (uint64_t)header.vertexCount;
+		uint64_t arrays[6][2] = {
+			{ header.x, streamSize },
+			{ header.y, streamSize },
+			{ header.z, streamSize },
+			{ header.w, streamSize },
+			{ header.attributes, sizeof(payload) * (uint64_t)header.vertexCount },
+			{ header.indices, sizeof(int) * (uint64_t)header.polygonCount * (uint64_t)header.cornersPerPolygon }
+		};
+		valid = memcmp(header.magic, meshFileMagic, sizeof(meshFileMagic)) == 0
+			&& header.version == meshFileVersion
+			&& header.vertexCount >= 0 && header.polygonCount >= 0
+			&& header.cornersPerPolygon >= 3 && header.cornersPerPolygon <= maxClipVertices - 6;
+		for (int i = 0; valid && i < 6; ++i) {
+			valid = arrays[i][0] % meshFileAlignment == 0 && arrays[i][0] <= size && arrays[i][1] <= size - arrays[i][0];
+		}
+
+		//checked once here, so nothing drawing the mesh has to
+		const int* fileIndices = reinterpret_cast<const int*>(base + header.indices);
+		int64_t indexCount = (int64_t)header.polygonCount * header.cornersPerPolygon;
+		for (int64_t i = 0; valid && i < indexCount; ++i) {
+			valid = fileIndices[i] >= 0 && fileIndices[i] < header.vertexCount;
+		}
+	}
+	if (!valid) {
+		message << "\"" << filename << "\" isn't a valid mesh file.";
+		vkLogging::Logger::get_logger()->print(message.str());
+		close();
+		return false;
+	}
+
+	//pointer fixups are all the loading there is. The mapping is read only,
+	//but the transform stage only ever reads the positions.
+	positions.x = reinterpret_cast<float*>(const_cast<char*>(base) + header.x);
+	positions.y = reinterpret_cast<float*>(const_cast<char*>(base) + header.y);
+	positions.z = reinterpret_cast<float*>(const_cast<char*>(base) + header.z);
+	positions.w = reinterpret_cast<float*>(const_cast<char*>(base) + header.w);
+	positions.count = header.vertexCount;
+	attributes = reinterpret_cast<const payload*>(base + header.attributes);
+	indices = reinterpret_cast<const int*>(base + header.indices);
+	polygonCount = header.polygonCount;
+	cornersPerPolygon = header.cornersPerPolygon;
+
+	return true;
+}
+
+void geometry::MappedMesh::close() {
+
+	if (view) {
+#ifdef _WIN32
+		UnmapViewOfFile(view);
+#else
+		munmap(view, size);
+#endif
+	}
+
+	view = nullptr;
+	size = 0;
+	positions = {};
+	attributes = nullptr;
+	indices = nullptr;
+	polygonCount = 0;
+}
+
+const int* geometry::MappedMesh::polygon(int i) const {
+
+	return indices + cornersPerPolygon * i;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "../../config.h"
+#include "../../linear_algebros.h"
+
+namespace geometry {
+
+	/**
+		Alignment of every array in a mesh file (in bytes)
+	*/
+	const size_t meshFileAlignment = 64;
+
+	/**
+		Start of a converted mesh file. The arrays follow it in the same
+		layout the transform stage consumes (positions as a structure of
+		arrays, then attributes, then polygon indices), each one starting
+		on a meshFileAlignment boundary, so the file can be used in place.
+	*/
+	struct MeshFileHeader {
+		char magic[4];
+		uint32_t version;
+		int32_t vertexCount;
+		int32_t polygonCount;
+		int32_t cornersPerPolygon;
+		int32_t padding;
+		//byte offsets from the start of the file
+		uint64_t x, y, z, w;
+		uint64_t attributes;
+		uint64_t indices;
+	};
+
+	/**
+		Read a Wavefront OBJ file and write it out as a mesh file.
+		Faces are split into triangle fans, and each unique pair of position
+		and texture coordinate becomes one vertex. Colors are left white and
+		texture coordinates are flipped vertically to match the engine's textures.
+
+		\param objFilename the OBJ file to read
+		\param meshFilename the mesh file to write
+		\returns whether the conversion succeeded
+	*/
+	bool convert_obj(const char* objFilename, const char* meshFilename);
+
+	/**
+		A mesh file mapped into memory and used in place: opening one is a
+		memory map and a few pointer fixups, with no parsing or copying.
+	*/
+	class MappedMesh {
+
+	public:
+
+		vertexStream positions{};
+		const payload* attributes{ nullptr };
+		const int* indices{ nullptr };
+		int polygonCount{ 0 };
+		int cornersPerPolygon{ 3 };
+
+		MappedMesh() = default;
+		MappedMesh(const MappedMesh&) = delete;
+		MappedMesh& operator=(const MappedMesh&) = delete;
+		~MappedMesh();
+
+		/**
+			Map a mesh file, replacing whatever was mapped before.
+
+			\param filename the mesh file to map
+			\returns whether the file was mapped and its layout checked out
+		*/
+		bool open(const char* filename);
+
+		/**
+			Unmap the file, if one is mapped.
+		*/
+		void close();
+
+		/**
+			\param i the index of a polygon
+			\returns the indices of the polygon's corners
+		*/
+		const int* polygon(int i) const;
+
+	private:
+
+		void* view{ nullptr };
+		size_t size{ 0 };
+	};
+}
@@ -1,33 +1,505 @@
-#include "graphics_library.h"
-
-unsigned char* convert_to_r8g8b8a8_unorm(float r, float g, float b) {
-
-	unsigned char color[4];
-
-	r = std::max(std::min(r, 0.99f), 0.0f);
-	g = std::max(std::min(g, 0.99f), 0.0f);
-	b = std::max(std::min(b, 0.99f), 0.0f);
-
-	color[0] = static_cast<unsigned char>(r * 0xFF);
-	color[1] = static_cast<unsigned char>(g * 0xFF);
-	color[2] = static_cast<unsigned char>(b * 0xFF);
-	color[3] = static_cast<unsigned char>(0xFF);
-
-	return color;
-}
-
-unsigned char* convert_to_b8g8r8a8_unorm(float r, float g, float b) {
-
-	unsigned char color[4];
-
-	r = std::max(std::min(r, 0.99f), 0.0f);
-	g = std::max(std::min(g, 0.99f), 0.0f);
-	b = std::max(std::min(b, 0.99f), 0.0f);
-
-	color[0] = static_cast<unsigned char>(b * 0xFF);
-	color[1] = static_cast<unsigned char>(g * 0xFF);
-	color[2] = static_cast<unsigned char>(r * 0xFF);
-	color[3] = static_cast<unsigned char>(0xFF);
-
-	return color;
+#include "graphics_library.h"
+#include <math.h>
+#include <new>
+
+unsigned char* convert_to_r8g8b8a8_unorm(float r, float g, float b) {
+
+	//returned by pointer, so it must outlive the call
+	static thread_local unsigned char color[4];
+
+	r = std::max(std::min(r, 0.99f), 0.0f);
+	g = std::max(std::min(g, 0.99f), 0.0f);
+	b = std::max(std::min(b, 0.99f), 0.0f);
+
+	color[0] = static_cast<unsigned char>(r * 0xFF);
+	color[1] = static_cast<unsigned char>(g * 0xFF);
+	color[2] = static_cast<unsigned char>(b * 0xFF);
+	color[3] = static_cast<unsigned char>(0xFF);
+
+	return color;
+}
+
+unsigned char* convert_to_b8g8r8a8_unorm(float r, float g, float b) {
+
+	//returned by pointer, so it must outlive the call
+	static thread_local unsigned char color[4];
+
+	r = std::max(std::min(r, 0.99f), 0.0f);
+	g = std::max(std::min(g, 0.99f), 0.0f);
+	b = std::max(std::min(b, 0.99f), 0.0f);
+
+	color[0] = static_cast<unsigned char>(b * 0xFF);
+	color[1] = static_cast<unsigned char>(g * 0xFF);
+	color[2] = static_cast<unsigned char>(r * 0xFF);
+	color[3] = static_cast<unsigned char>(0xFF);
+
+	return color;
+}
+
+void sample_bilinear(texture& tex, float u, float v, float& r, float& g, float& b) {
+
+	int u_left = std::min(tex.width - 1, std::max(0, (int)(tex.width * u)));
+	int u_right = std::min(tex.width - 1, std::max(0, u_left + 1));
+	float frac_u = tex.width * u - u_left;
+	float left = 1.0f - frac_u;
+	float right = frac_u;
+
+	int v_top = std::min(tex.height - 1, std::max(0, (int)(tex.height * v)));
+	int v_bottom = std::min(tex.height - 1, std::max(0, v_top + 1));
+	float frac_v = tex.height * v - v_top;
+	float top = 1.0f - frac_v;
+	float bottom = frac_v;
+
+	r = top * (
+			left * tex.r[v_top * tex.width + u_left] + right * tex.r[v_top * tex.width + u_right]
+		)
+		+ bottom * (
+			left * tex.r[v_bottom * tex.width + u_left] + right * tex.r[v_bottom * tex.width + u_right]
+		);
+
+	g = top * (
+			left * tex.g[v_top * tex.width + u_left] + right * tex.g[v_top * tex.width + u_right]
+		)
+		+ bottom * (
+			left * tex.g[v_bottom * tex.width + u_left] + right * tex.g[v_bottom * tex.width + u_right]
+		);
+
+	b = top * (
+			left * tex.b[v_top * tex.width + u_left] + right * tex.b[v_top * tex.width + u_right]
+		)
+		+ bottom * (
+			left * tex.b[v_bottom * tex.width + u_left] + right * tex.b[v_bottom * tex.width + u_right]
+		);
+}
+
+namespace {
+
+	//index of texel (x, y) in a layout of 4x4 tiles, each one 16 consecutive texels
+	inline int tiled_index(int x, int y, int tilesPerRow) {
+		return (((y >> 2) * tilesPerRow + (x >> 2)) << 4) | ((y & 3) << 2) | (x & 3);
+	}
+
+	inline __m256i tiled_index_avx2(__m256i x, __m256i y, __m256i tilesPerRow) {
+		__m256i three = _mm256_set1_epi32(3);
+		__m256i tile = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(y, 2), tilesPerRow), _mm256_srli_epi32(x, 2));
+		return _mm256_or_si256(_mm256_slli_epi32(tile, 4),
+			_mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(y, three), 2), _mm256_and_si256(x, three)));
+	}
+}
+
+void sample_bilinear_packed(const texture& tex, float u, float v, float& r, float& g, float& b) {
+
+	int u_left = std::min(tex.width - 1, std::max(0, (int)(tex.width * u)));
+	int u_right = std::min(tex.width - 1, std::max(0, u_left + 1));
+	float right = tex.width * u - u_left;
+	float left = 1.0f - right;
+
+	int v_top = std::min(tex.height - 1, std::max(0, (int)(tex.height * v)));
+	int v_bottom = std::min(tex.height - 1, std::max(0, v_top + 1));
+	float bottom = tex.height * v - v_top;
+	float top = 1.0f - bottom;
+
+	int taps[4] = {
+		(int)tex.texels[tiled_index(u_left, v_top, tex.tilesPerRow)],
+		(int)tex.texels[tiled_index(u_right, v_top, tex.tilesPerRow)],
+		(int)tex.texels[tiled_index(u_left, v_bottom, tex.tilesPerRow)],
+		(int)tex.texels[tiled_index(u_right, v_bottom, tex.tilesPerRow)]
+	};
+	float weights[4] = { top * left, top * right, bottom * left, bottom * right };
+
+	//widen each texel's bytes to (r, g, b, a) floats and blend all four channels at once
+	__m128 sum = _mm_setzero_ps();
+	for (int i = 0; i < 4; ++i) {
+		__m128 texel = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(taps[i])));
+		sum = _mm_fmadd_ps(_mm_set1_ps(weights[i]), texel, sum);
+	}
+
+	float channels[4];
+	_mm_storeu_ps(channels, _mm_mul_ps(sum, _mm_set1_ps(1.0f / 255)));
+	r = channels[0];
+	g = channels[1];
+	b = channels[2];
+}
+
+void sample_bilinear_packed_avx2(const texture& tex, __m256 u, __m256 v, __m256& r, __m256& g, __m256& b) {
+
+	__m256i zero = _mm256_setzero_si256();
+	__m256i one = _mm256_set1_epi32(1);
+	__m256i maxU = _mm256_set1_epi32(tex.width - 1);
+	__m256i maxV = _mm256_set1_epi32(tex.height - 1);
+
+	__m256 texelU = _mm256_mul_ps(_mm256_set1_ps((float)tex.width), u);
+	__m256i u_left = _mm256_min_epi32(maxU, _mm256_max_epi32(zero, _mm256_cvttps_epi32(texelU)));
+	__m256i u_right = _mm256_min_epi32(maxU, _mm256_add_epi32(u_left, one));
+	__m256 right = _mm256_sub_ps(texelU, _mm256_cvtepi32_ps(u_left));
+	__m256 left = _mm256_sub_ps(_mm256_set1_ps(1.0f), right);
+
+	__m256 texelV = _mm256_mul_ps(_mm256_set1_ps((float)tex.height), v);
+	__m256i v_top = _mm256_min_epi32(maxV, _mm256_max_epi32(zero, _mm256_cvttps_epi32(texelV)));
+	__m256i v_bottom = _mm256_min_epi32(maxV, _mm256_add_epi32(v_top, one));
+	__m256 bottom = _mm256_sub_ps(texelV, _mm256_cvtepi32_ps(v_top));
+	__m256 top = _mm256_sub_ps(_mm256_set1_ps(1.0f), bottom);
+
+	//four gathers fetch every channel of every tap
+	__m256i tilesPerRow = _mm256_set1_epi32(tex.tilesPerRow);
+	const int* texels = reinterpret_cast<const int*>(tex.texels);
+	__m256i topLeft = _mm256_i32gather_epi32(texels, tiled_index_avx2(u_left, v_top, tilesPerRow), 4);
+	__m256i topRight = _mm256_i32gather_epi32(texels, tiled_index_avx2(u_right, v_top, tilesPerRow), 4);
+	__m256i bottomLeft = _mm256_i32gather_epi32(texels, tiled_index_avx2(u_left, v_bottom, tilesPerRow), 4);
+	__m256i bottomRight = _mm256_i32gather_epi32(texels, tiled_index_avx2(u_right, v_bottom, tilesPerRow), 4);
+
+	__m256i byteMask = _mm256_set1_epi32(0xFF);
+	__m256 scale = _mm256_set1_ps(1.0f / 255);
+	__m256* results[3] = { &r, &g, &b };
+
+	for (int channel = 0; channel < 3; ++channel) {
+		__m256 tl = _mm256_cvtepi32_ps(_mm256_and_si256(topLeft, byteMask));
+		__m256 tr = _mm256_cvtepi32_ps(_mm256_and_si256(topRight, byteMask));
+		__m256 bl = _mm256_cvtepi32_ps(_mm256_and_si256(bottomLeft, byteMask));
+		__m256 br = _mm256_cvtepi32_ps(_mm256_and_si256(bottomRight, byteMask));
+
+		__m256 upper = _mm256_fmadd_ps(left, tl, _mm256_mul_ps(right, tr));
+		__m256 lower = _mm256_fmadd_ps(left, bl, _mm256_mul_ps(right, br));
+		*results[channel] = _mm256_mul_ps(_mm256_fmadd_ps(top, upper, _mm256_mul_ps(bottom, lower)), scale);
+
+		topLeft = _mm256_srli_epi32(topLeft, 8);
+		topRight = _mm256_srli_epi32(topRight, 8);
+		bottomLeft = _mm256_srli_epi32(bottomLeft, 8);
+		bottomRight = _mm256_srli_epi32(bottomRight, 8);
+	}
+}
+
+void pack_texture_tiled(texture& tex) {
+
+	size_t texelCount = 0;
+	for (int i = 0; i < tex.levelCount; ++i) {
+		texture& level = tex.levels[i];
+		level.tilesPerRow = (level.width + 3) / 4;
+		texelCount += 16 * (size_t)level.tilesPerRow * ((level.height + 3) / 4);
+	}
+
+	uint32_t* texels = static_cast<uint32_t*>(operator new(texelCount * sizeof(uint32_t), std::align_val_t(64)));
+
+	size_t offset = 0;
+	for (int i = 0; i < tex.levelCount; ++i) {
+
+		texture& level = tex.levels[i];
+		level.texels = texels + offset;
+		offset += 16 * (size_t)level.tilesPerRow * ((level.height + 3) / 4);
+
+		//tiles hanging off the right and bottom edges repeat the edge texels
+		for (int y = 0; y < 4 * ((level.height + 3) / 4); ++y) {
+			for (int x = 0; x < 4 * level.tilesPerRow; ++x) {
+				int source = level.width * std::min(y, level.height - 1) + std::min(x, level.width - 1);
+				uint32_t red = (uint32_t)(255.0f * level.r[source] + 0.5f);
+				uint32_t green = (uint32_t)(255.0f * level.g[source] + 0.5f);
+				uint32_t blue = (uint32_t)(255.0f * level.b[source] + 0.5f);
+				level.texels[tiled_index(x, y, level.tilesPerRow)] = red | (green << 8) | (blue << 16) | 0xFF000000;
+			}
+		}
+	}
+
+	free(tex.r);
+	free(tex.g);
+	free(tex.b);
+	for (int i = 0; i < tex.levelCount; ++i) {
+		tex.levels[i].r = tex.levels[i].g = tex.levels[i].b = nullptr;
+	}
+
+	tex.r = tex.g = tex.b = nullptr;
+	tex.texels = texels;
+	tex.tilesPerRow = tex.levels[0].tilesPerRow;
+}
+
+void sample_bilinear_avx2(texture& tex, __m256 u, __m256 v, __m256& r, __m256& g, __m256& b) {
+
+	__m256i zero = _mm256_setzero_si256();
+	__m256i one = _mm256_set1_epi32(1);
+	__m256i maxU = _mm256_set1_epi32(tex.width - 1);
+	__m256i maxV = _mm256_set1_epi32(tex.height - 1);
+
+	__m256 texelU = _mm256_mul_ps(_mm256_set1_ps((float)tex.width), u);
+	__m256i u_left = _mm256_min_epi32(maxU, _mm256_max_epi32(zero, _mm256_cvttps_epi32(texelU)));
+	__m256i u_right = _mm256_min_epi32(maxU, _mm256_add_epi32(u_left, one));
+	__m256 right = _mm256_sub_ps(texelU, _mm256_cvtepi32_ps(u_left));
+	__m256 left = _mm256_sub_ps(_mm256_set1_ps(1.0f), right);
+
+	__m256 texelV = _mm256_mul_ps(_mm256_set1_ps((float)tex.height), v);
+	__m256i v_top = _mm256_min_epi32(maxV, _mm256_max_epi32(zero, _mm256_cvttps_epi32(texelV)));
+	__m256i v_bottom = _mm256_min_epi32(maxV, _mm256_add_epi32(v_top, one));
+	__m256 bottom = _mm256_sub_ps(texelV, _mm256_cvtepi32_ps(v_top));
+	__m256 top = _mm256_sub_ps(_mm256_set1_ps(1.0f), bottom);
+
+	__m256i rowTop = _mm256_mullo_epi32(v_top, _mm256_set1_epi32(tex.width));
+	__m256i rowBottom = _mm256_mullo_epi32(v_bottom, _mm256_set1_epi32(tex.width));
+	__m256i topLeft = _mm256_add_epi32(rowTop, u_left);
+	__m256i topRight = _mm256_add_epi32(rowTop, u_right);
+	__m256i bottomLeft = _mm256_add_epi32(rowBottom, u_left);
+	__m256i bottomRight = _mm256_add_epi32(rowBottom, u_right);
+
+	float* channels[3] = { tex.r, tex.g, tex.b };
+	__m256* results[3] = { &r, &g, &b };
+
+	for (int i = 0; i < 3; ++i) {
+		__m256 upper = _mm256_fmadd_ps(left, _mm256_i32gather_ps(channels[i], topLeft, 4),
+			_mm256_mul_ps(right, _mm256_i32gather_ps(channels[i], topRight, 4)));
+		__m256 lower = _mm256_fmadd_ps(left, _mm256_i32gather_ps(channels[i], bottomLeft, 4),
+			_mm256_mul_ps(right, _mm256_i32gather_ps(channels[i], bottomRight, 4)));
+		*results[i] = _mm256_fmadd_ps(top, upper, _mm256_mul_ps(bottom, lower));
+	}
+}
+
+__m256 reciprocal_avx2(__m256 x) {
+
+	//x0 ~ 1/x to 12 bits, then x1 = x0 (2 - x x0)
+	__m256 estimate = _mm256_rcp_ps(x);
+	return _mm256_mul_ps(estimate, _mm256_fnmadd_ps(x, estimate, _mm256_set1_ps(2.0f)));
+}
+
+void downsample_box_avx2(const texture& source, texture& destination) {
+
+	const float* sourceChannels[3] = { source.r, source.g, source.b };
+	float* destinationChannels[3] = { destination.r, destination.g, destination.b };
+	__m256 half = _mm256_set1_ps(0.5f);
+
+	//an odd source leaves a row and column over, the last destination
+	//row and column take in three source texels instead of two
+	bool oddWidth = source.width > 2 * destination.width;
+	bool oddHeight = source.height > 2 * destination.height;
+	int pairedWidth = destination.width - (oddWidth ? 1 : 0);
+
+	for (int channel = 0; channel < 3; ++channel) {
+		for (int y = 0; y < destination.height; ++y) {
+
+			int rowCount = (oddHeight && y == destination.height - 1) ? 3 : 2;
+			float rowWeight = 1.0f / rowCount;
+			const float* rows[3];
+			float rowWeights[3];
+			for (int i = 0; i < 3; ++i) {
+				rows[i] = sourceChannels[channel] + source.width * std::min(2 * y + i, source.height - 1);
+				rowWeights[i] = (i < rowCount) ? rowWeight : 0.0f;
+			}
+			float* row = destinationChannels[channel] + destination.width * y;
+
+			//each source column weighted down to one texel
+			auto column = [&](int x) {
+				return rowWeights[0] * rows[0][x] + rowWeights[1] * rows[1][x] + rowWeights[2] * rows[2][x];
+			};
+			auto columns = [&](int x) {
+				__m256 sum = _mm256_mul_ps(_mm256_loadu_ps(rows[0] + x), _mm256_set1_ps(rowWeights[0]));
+				sum = _mm256_fmadd_ps(_mm256_loadu_ps(rows[1] + x), _mm256_set1_ps(rowWeights[1]), sum);
+				if (rowCount == 3) {
+					sum = _mm256_fmadd_ps(_mm256_loadu_ps(rows[2] + x), _mm256_set1_ps(rowWeights[2]), sum);
+				}
+				return sum;
+			};
+
+			int x = 0;
+			for (; 2 * x + 16 <= source.width && x + 8 <= pairedWidth; x += 8) {
+				__m256 a = columns(2 * x);
+				__m256 b = columns(2 * x + 8);
+				//pairwise sums come out as a01 a23 b01 b23 | a45 a67 b45 b67, swap the middle pairs back
+				__m256 sums = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_hadd_ps(a, b)), 0xD8));
+				_mm256_storeu_ps(row + x, _mm256_mul_ps(sums, half));
+			}
+
+			for (; x < destination.width; ++x) {
+				int columnCount = (oddWidth && x == destination.width - 1) ? 3 : 2;
+				float sum = 0.0f;
+				for (int i = 0; i < columnCount; ++i) {
+					sum += column(std::min(2 * x + i, source.width - 1));
+				}
+				row[x] = sum / columnCount;
+			}
+		}
+	}
+}
+
+namespace {
+
+	int64_t floor_divide(int64_t numerator, int64_t denominator) {
+
+		int64_t quotient = numerator / denominator;
+		if ((numerator % denominator != 0) && ((numerator < 0) != (denominator < 0))) {
+			--quotient;
+		}
+		return quotient;
+	}
+}
+
+edgeStepper make_edge_stepper(int x1, int y1, int x2, int y2, int clip_y1, int clip_y2) {
+
+	const int half = subpixelScale / 2;
+
+	edgeStepper edge;
+
+	//rows whose centres (subpixelScale * y + half) are in [y1, y2)
+	edge.y = std::max(clip_y1, (int)floor_divide((int64_t)y1 - half + subpixelScale - 1, subpixelScale));
+	edge.yEnd = std::min(clip_y2, (int)floor_divide((int64_t)y2 - half + subpixelScale - 1, subpixelScale));
+	if (edge.y >= edge.yEnd) {
+		edge.yEnd = edge.y;
+		edge.x = 0;
+		edge.remainder = edge.stepRemainder = edge.stepX = 0;
+		edge.denominator = 1;
+		return edge;
+	}
+
+	//the crossing of row y's centre line is at x1 + dx (centre - y1) / dy, and the first
+	//pixel centre on or right of it is the ceiling of (crossing - half) / subpixelScale
+	int64_t dx = (int64_t)x2 - x1;
+	int64_t dy = (int64_t)y2 - y1;
+	edge.denominator = subpixelScale * dy;
+	int64_t numerator = ((int64_t)x1 - half) * dy + dx * ((int64_t)subpixelScale * edge.y + half - y1)
+		+ edge.denominator - 1;
+	int64_t x = floor_divide(numerator, edge.denominator);
+	edge.x = (int)x;
+	edge.remainder = numerator - x * edge.denominator;
+
+	//each row moves the numerator on by subpixelScale * dx
+	int64_t stepX = floor_divide(subpixelScale * dx, edge.denominator);
+	edge.stepX = (int)stepX;
+	edge.stepRemainder = subpixelScale * dx - stepX * edge.denominator;
+
+	return edge;
+}
+
+payload attribute_gradient_y(const vertex* corners, int cornerCount) {
+
+	int best = 0;
+	float bestArea = 0.0f;
+	for (int i = 1; i + 1 < cornerCount; ++i) {
+		float area = (float)(corners[i].x - corners[0].x) * (corners[i + 1].y - corners[0].y)
+			- (float)(corners[i + 1].x - corners[0].x) * (corners[i].y - corners[0].y);
+		if (fabsf(area) > fabsf(bestArea)) {
+			best = i;
+			bestArea = area;
+		}
+	}
+
+	payload gradient;
+	gradient.lump = _mm256_setzero_ps();
+	if (bestArea == 0.0f) {
+		return gradient;
+	}
+
+	const vertex& a = corners[0];
+	const vertex& b = corners[best];
+	const vertex& c = corners[best + 1];
+
+	//P = Pa + dPdx (x - xa) + dPdy (y - ya), solved for dPdy with Cramer's rule,
+	//then scaled from per subpixel to per pixel
+	__m256 dPb = _mm256_sub_ps(b.attributes.lump, a.attributes.lump);
+	__m256 dPc = _mm256_sub_ps(c.attributes.lump, a.attributes.lump);
+	gradient.lump = _mm256_div_ps(
+		_mm256_fmsub_ps(_mm256_set1_ps((float)(b.x - a.x)), dPc, _mm256_mul_ps(_mm256_set1_ps((float)(c.x - a.x)), dPb)),
+		_mm256_set1_ps(bestArea / subpixelScale)
+	);
+
+	return gradient;
+}
+
+float level_of_detail(const texture& tex, const payload& attributes, const payload& dPdx, const payload& dPdy, bool perspective) {
+
+	float dudx = dPdx.data[3];
+	float dvdx = dPdx.data[4];
+	float dudy = dPdy.data[3];
+	float dvdy = dPdy.data[4];
+
+	//quotient rule, with q = 1/w: d(u) = (d(u q) - u d(q)) / q
+	if (perspective) {
+		float w = 1.0f / attributes.data[7];
+		float u = attributes.data[3] * w;
+		float v = attributes.data[4] * w;
+		dudx = (dudx - u * dPdx.data[7]) * w;
+		dvdx = (dvdx - v * dPdx.data[7]) * w;
+		dudy = (dudy - u * dPdy.data[7]) * w;
+		dvdy = (dvdy - v * dPdy.data[7]) * w;
+	}
+
+	dudx *= tex.width;
+	dudy *= tex.width;
+	dvdx *= tex.height;
+	dvdy *= tex.height;
+
+	float footprint = std::max(dudx * dudx + dvdx * dvdx, dudy * dudy + dvdy * dvdy);
+	return 0.5f * log2f(footprint);
+}
+
+mipSelection select_mip_levels(texture& tex, float lod, textureFilter filter) {
+
+	mipSelection mips = { &tex, nullptr, 0.0f };
+
+	//also catches a NaN level of detail from degenerate derivatives
+	if (filter == textureFilter::bilinear || tex.levelCount < 2 || !(lod > 0.0f)) {
+		return mips;
+	}
+
+	int lastLevel = tex.levelCount - 1;
+	lod = std::min(lod, (float)lastLevel);
+
+	if (filter == textureFilter::nearestMip) {
+		mips.fine = &tex.levels[(int)(lod + 0.5f)];
+		return mips;
+	}
+
+	int level = (int)lod;
+	mips.fine = &tex.levels[level];
+	if (level < lastLevel) {
+		mips.coarse = &tex.levels[level + 1];
+		mips.blend = lod - level;
+	}
+
+	return mips;
+}
+
+void sample_mipmapped(const mipSelection& mips, float u, float v, float& r, float& g, float& b) {
+
+	//every level of a texture has the same layout
+	bool packed = mips.fine->texels != nullptr;
+
+	if (packed) {
+		sample_bilinear_packed(*mips.fine, u, v, r, g, b);
+	}
+	else {
+		sample_bilinear(*mips.fine, u, v, r, g, b);
+	}
+
+	if (mips.coarse) {
+		float coarseR, coarseG, coarseB;
+		if (packed) {
+			sample_bilinear_packed(*mips.coarse, u, v, coarseR, coarseG, coarseB);
+		}
+		else {
+			sample_bilinear(*mips.coarse, u, v, coarseR, coarseG, coarseB);
+		}
+		r += mips.blend * (coarseR - r);
+		g += mips.blend * (coarseG - g);
+		b += mips.blend * (coarseB - b);
+	}
+}
+
+void sample_mipmapped_avx2(const mipSelection& mips, __m256 u, __m256 v, __m256& r, __m256& g, __m256& b) {
+
+	bool packed = mips.fine->texels != nullptr;
+
+	if (packed) {
+		sample_bilinear_packed_avx2(*mips.fine, u, v, r, g, b);
+	}
+	else {
+		sample_bilinear_avx2(*mips.fine, u, v, r, g, b);
+	}
+
+	if (mips.coarse) {
+		__m256 coarseR, coarseG, coarseB;
+		if (packed) {
+			sample_bilinear_packed_avx2(*mips.coarse, u, v, coarseR, coarseG, coarseB);
+		}
+		else {
+			sample_bilinear_avx2(*mips.coarse, u, v, coarseR, coarseG, coarseB);
+		}
+		__m256 blend = _mm256_set1_ps(mips.blend);
+		r = _mm256_fmadd_ps(blend, _mm256_sub_ps(coarseR, r), r);
+		g = _mm256_fmadd_ps(blend, _mm256_sub_ps(coarseG, g), g);
+		b = _mm256_fmadd_ps(blend, _mm256_sub_ps(coarseB, b), b);
+	}
 }
\ No newline at end of file
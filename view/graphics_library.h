@@ -1,6 +1,300 @@
-#pragma once
-#include "../config.h"
-
-unsigned char* convert_to_r8g8b8a8_unorm(float r, float g, float b);
-
-unsigned char* convert_to_b8g8r8a8_unorm(float r, float g, float b);
\ No newline at end of file
+#pragma once
+#include "../config.h"
+#include "vkImage/image.h"
+#include "../linear_algebros.h"
+#include <cmath>
+
+unsigned char* convert_to_r8g8b8a8_unorm(float r, float g, float b);
+
+unsigned char* convert_to_b8g8r8a8_unorm(float r, float g, float b);
+
+/**
+	Convert a float color to a packed 8 bit pixel in a swapchain format,
+	clamping and scaling exactly as the conversion functions above do.
+
+	\param r the red value
+	\param g the green value
+	\param b the blue value
+	\returns the pixel, alpha set to 255
+*/
+template<vk::Format format>
+inline uint32_t pack_color(float r, float g, float b) {
+
+	uint32_t red = static_cast<uint32_t>(std::max(std::min(r, 0.99f), 0.0f) * 0xFF);
+	uint32_t green = static_cast<uint32_t>(std::max(std::min(g, 0.99f), 0.0f) * 0xFF);
+	uint32_t blue = static_cast<uint32_t>(std::max(std::min(b, 0.99f), 0.0f) * 0xFF);
+
+	if constexpr (format == vk::Format::eB8G8R8A8Unorm) {
+		return blue | (green << 8) | (red << 16) | 0xFF000000u;
+	}
+	else {
+		return red | (green << 8) | (blue << 16) | 0xFF000000u;
+	}
+}
+
+/**
+	Convert eight float colors to packed 8 bit pixels in a swapchain format,
+	clamping and scaling exactly as pack_color does.
+
+	\param r the red values
+	\param g the green values
+	\param b the blue values
+	\returns the pixels, alpha set to 255
+*/
+template<vk::Format format>
+inline __m256i pack_colors_avx2(__m256 r, __m256 g, __m256 b) {
+
+	__m256 ceiling = _mm256_set1_ps(0.99f);
+	__m256 scale = _mm256_set1_ps(255.0f);
+
+	//only the top needs clamping, negatives saturate to 0 when they're packed
+	__m256i red = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_min_ps(r, ceiling), scale));
+	__m256i green = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_min_ps(g, ceiling), scale));
+	__m256i blue = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_min_ps(b, ceiling), scale));
+
+	//each 128 bit half now holds four pixels as planes: rrrr gggg bbbb aaaa
+	__m256i planes = _mm256_packus_epi16(
+		_mm256_packus_epi32(red, green),
+		_mm256_packus_epi32(blue, _mm256_set1_epi32(0xFF)));
+
+	//so interleave them, in whichever order the format wants
+	__m256i order;
+	if constexpr (format == vk::Format::eB8G8R8A8Unorm) {
+		order = _mm256_setr_epi8(
+			8, 4, 0, 12, 9, 5, 1, 13, 10, 6, 2, 14, 11, 7, 3, 15,
+			8, 4, 0, 12, 9, 5, 1, 13, 10, 6, 2, 14, 11, 7, 3, 15);
+	}
+	else {
+		order = _mm256_setr_epi8(
+			0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15,
+			0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+	}
+
+	return _mm256_shuffle_epi8(planes, order);
+}
+
+/**
+	Polygon corners are snapped to 28.4 fixed point before they're rasterized:
+	4 bits below the pixel, the rest above it. Coverage is then decided with
+	integer arithmetic only, so neighbouring polygons agree on shared edges.
+*/
+const int subpixelBits = 4;
+const int subpixelScale = 1 << subpixelBits;
+
+/**
+	Snap a screen coordinate to the subpixel grid.
+
+	\param coordinate the coordinate (in pixels)
+	\returns the nearest 28.4 fixed point coordinate
+*/
+inline int snap_to_subpixel(float coordinate) {
+
+	return static_cast<int>(lrintf(coordinate * subpixelScale));
+}
+
+/**
+	\param coordinate a 28.4 fixed point coordinate
+	\returns the pixel (row or column) it lies in
+*/
+inline int subpixel_to_pixel(int coordinate) {
+
+	return coordinate >> subpixelBits;
+}
+
+/**
+	An edge being walked down the rows whose pixel centres it crosses, with
+	the first pixel whose centre lies on or right of it in each row. Rows are
+	those with centres in [top, bottom) of the edge, so with spans running from
+	the left edge's pixel up to (not including) the right edge's, a pixel centre
+	exactly on an edge belongs to the polygon only if the edge is a top or left
+	one. Two polygons sharing an edge step it identically, so each pixel along
+	it is covered exactly once.
+*/
+struct edgeStepper {
+	//the current row, and one past the last
+	int y, yEnd;
+	//the pixel in the current row
+	int x;
+	//x is the ceiling of a fraction, remainder/denominator being what was rounded off
+	int64_t remainder, denominator;
+	int stepX;
+	int64_t stepRemainder;
+};
+
+/**
+	Set up the walk of an edge between two snapped corners.
+
+	\param x1 the top corner's x (28.4 fixed point)
+	\param y1 the top corner's y (28.4 fixed point)
+	\param x2 the bottom corner's x (28.4 fixed point)
+	\param y2 the bottom corner's y (28.4 fixed point), at least y1
+	\param clip_y1 the first row which may be walked
+	\param clip_y2 one past the last row which may be walked
+	\returns the edge, at its first row within [clip_y1, clip_y2)
+*/
+edgeStepper make_edge_stepper(int x1, int y1, int x2, int y2, int clip_y1, int clip_y2);
+
+/**
+	Move an edge down to its next row, exactly.
+
+	\param edge the edge to step
+*/
+inline void advance_edge(edgeStepper& edge) {
+
+	++edge.y;
+	edge.x += edge.stepX;
+	edge.remainder += edge.stepRemainder;
+	if (edge.remainder >= edge.denominator) {
+		++edge.x;
+		edge.remainder -= edge.denominator;
+	}
+}
+
+/**
+	The mip levels a span samples from, chosen once for the whole span.
+*/
+struct mipSelection {
+	texture* fine;
+	//null unless two levels are blended
+	texture* coarse;
+	//how much of the coarse level to blend in
+	float blend;
+};
+
+/**
+	Bilinearly sample a texture at eight coordinates at once,
+	filtering and clamping exactly as the scalar span loop does.
+
+	\param tex the texture to sample
+	\param u the horizontal texture coordinates
+	\param v the vertical texture coordinates
+	\param r set to the sampled red values
+	\param g set to the sampled green values
+	\param b set to the sampled blue values
+*/
+void sample_bilinear_avx2(texture& tex, __m256 u, __m256 v, __m256& r, __m256& g, __m256& b);
+
+/**
+	Bilinearly sample a packed, tiled texture at eight coordinates at once:
+	each tap is one gather of whole RGBA8 texels, unpacked in registers.
+
+	\param tex the texture to sample
+	\param u the horizontal texture coordinates
+	\param v the vertical texture coordinates
+	\param r set to the sampled red values
+	\param g set to the sampled green values
+	\param b set to the sampled blue values
+*/
+void sample_bilinear_packed_avx2(const texture& tex, __m256 u, __m256 v, __m256& r, __m256& g, __m256& b);
+
+/**
+	Bilinearly sample a packed, tiled texture at a single coordinate.
+
+	\param tex the texture to sample
+	\param u the horizontal texture coordinate
+	\param v the vertical texture coordinate
+	\param r set to the sampled red value
+	\param g set to the sampled green value
+	\param b set to the sampled blue value
+*/
+void sample_bilinear_packed(const texture& tex, float u, float v, float& r, float& g, float& b);
+
+/**
+	Repack a planar texture (and its mip chain) as RGBA8 texels in 4x4 tiles,
+	freeing the float planes. Every level's tiles share one allocation,
+	aligned to a cache line.
+
+	\param tex the texture to repack
+*/
+void pack_texture_tiled(texture& tex);
+
+/**
+	Bilinearly sample a texture at a single coordinate.
+
+	\param tex the texture to sample
+	\param u the horizontal texture coordinate
+	\param v the vertical texture coordinate
+	\param r set to the sampled red value
+	\param g set to the sampled green value
+	\param b set to the sampled blue value
+*/
+void sample_bilinear(texture& tex, float u, float v, float& r, float& g, float& b);
+
+/**
+	Approximate 1/x for eight values, a reciprocal estimate refined
+	by one Newton-Raphson step (good to about 22 bits).
+
+	\param x the values to invert
+	\returns their reciprocals
+*/
+__m256 reciprocal_avx2(__m256 x);
+
+/**
+	Fill a mip level by averaging 2x2 blocks of the level above it,
+	8 destination texels at a time. The destination's size and storage
+	must already be set up. When the source's width or height is odd,
+	the last destination column or row averages three source texels
+	across instead of two, so every source texel is counted.
+
+	\param source the larger level
+	\param destination the level to fill, half the size of the source
+*/
+void downsample_box_avx2(const texture& source, texture& destination);
+
+/**
+	Compute how a projected polygon's attributes change from one row to the next.
+	Attributes (or attributes/w) are linear in screen space, so the plane through
+	any three corners will do, the largest fan triangle is used to keep rounding down.
+
+	\param corners the polygon's corners, snapped to 28.4 fixed point
+	\param cornerCount the number of corners
+	\returns the attributes' rate of change per pixel in y
+*/
+payload attribute_gradient_y(const vertex* corners, int cornerCount);
+
+/**
+	Estimate the mip level of detail at a point from its screen space derivatives,
+	the log2 of the larger side of the pixel's footprint in texels.
+
+	\param tex the texture being sampled
+	\param attributes the attributes at the point
+	\param dPdx the attributes' rate of change per pixel in x
+	\param dPdy the attributes' rate of change per pixel in y
+	\param perspective whether the attributes are divided by w, with 1/w in lane 7
+	\returns the level of detail, 0 or less means magnified
+*/
+float level_of_detail(const texture& tex, const payload& attributes, const payload& dPdx, const payload& dPdy, bool perspective);
+
+/**
+	Choose the levels to sample for a level of detail.
+
+	\param tex the texture to sample
+	\param lod the level of detail
+	\param filter how to filter between levels
+	\returns the chosen levels
+*/
+mipSelection select_mip_levels(texture& tex, float lod, textureFilter filter);
+
+/**
+	Sample chosen mip levels at a single coordinate.
+
+	\param mips the levels to sample
+	\param u the horizontal texture coordinate
+	\param v the vertical texture coordinate
+	\param r set to the sampled red value
+	\param g set to the sampled green value
+	\param b set to the sampled blue value
+*/
+void sample_mipmapped(const mipSelection& mips, float u, float v, float& r, float& g, float& b);
+
+/**
+	Sample chosen mip levels at eight coordinates at once.
+
+	\param mips the levels to sample
+	\param u the horizontal texture coordinates
+	\param v the vertical texture coordinates
+	\param r set to the sampled red values
+	\param g set to the sampled green values
+	\param b set to the sampled blue values
+*/
+void sample_mipmapped_avx2(const mipSelection& mips, __m256 u, __m256 v, __m256& r, __m256& g, __m256& b);
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "dirty_tiles.h"
+
+void raster::DirtyTiles::resize(int width, int height) {
+
+	this->width = width;
+	this->height = height;
+	tileCountX = (width + dirtyTileSize - 1) / dirtyTileSize;
+	tileCountY = (height + dirtyTileSize - 1) / dirtyTileSize;
+
+	dirty.assign(tileCountX * tileCountY, 0);
+}
+
+void raster::DirtyTiles::mark(int x1, int y1, int x2, int y2) {
+
+	x1 = std::max(0, x1);
+	y1 = std::max(0, y1);
+	x2 = std::min(width - 1, x2);
+	y2 = std::min(height - 1, y2);
+
+	if (x1 > x2 || y1 > y2) {
+		return;
+	}
+
+	for (int tileY = y1 / dirtyTileSize; tileY <= y2 / dirtyTileSize; ++tileY) {
+		unsigned char* row = dirty.data() + tileCountX * tileY;
+		std::fill(row + x1 / dirtyTileSize, row + x2 / dirtyTileSize + 1, 1);
+	}
+}
+
+void raster::DirtyTiles::mark(const edgeTable& polygon) {
+
+	int x_min = width, y_min = height, x_max = -1, y_max = -1;
+
+	for (int i = 0; i < polygon.vertexCount; ++i) {
+		x_min = std::min(x_min, (int)polygon.vertices[i].data[0]);
+		x_max = std::max(x_max, (int)polygon.vertices[i].data[0]);
+		y_min = std::min(y_min, (int)polygon.vertices[i].data[1]);
+		y_max = std::max(y_max, (int)polygon.vertices[i].data[1]);
+	}
+
+	//a pixel of slack either way, the rasterizers round rather than truncate in places
+	mark(x_min - 1, y_min - 1, x_max + 1, y_max + 1);
+}
+
+void raster::DirtyTiles::mark_all() {
+
+	std::fill(dirty.begin(), dirty.end(), 1);
+}
+
+void raster::DirtyTiles::merge(const DirtyTiles& other) {
+
+	for (size_t i = 0; i < dirty.size(); ++i) {
+		dirty[i] |= other.dirty[i];
+	}
+}
+
+void raster::DirtyTiles::clear() {
+
+	std::fill(dirty.begin(), dirty.end(), 0);
+}
+
+bool raster::DirtyTiles::empty() const {
+
+	return std::find(dirty.begin(), dirty.end(), 1) == dirty.end();
+}
+
+bool raster::DirtyTiles::full() const {
+
+	return std::find(dirty.begin(), dirty.end(), 0) == dirty.end();
+}
+
+void raster::DirtyTiles::regions(std::vector<vk::Rect2D>& rectangles) const {
+
+	rectangles.clear();
+
+	//rectangles reaching the bottom of the previous row of tiles, which a matching run extends
+	std::vector<size_t> open, stillOpen;
+
+	for (int tileY = 0; tileY < tileCountY; ++tileY) {
+
+		const unsigned char* row = dirty.data() + tileCountX * tileY;
+		int top = tileY * dirtyTileSize;
+		int bottom = std::min(height, top + dirtyTileSize);
+		stillOpen.clear();
+
+		for (int tileX = 0; tileX < tileCountX; ) {
+
+			if (!row[tileX]) {
+				++tileX;
+				continue;
+			}
+
+			int first = tileX;
+			while (tileX < tileCountX && row[tileX]) {
+				++tileX;
+			}
+
+			int left = first * dirtyTileSize;
+			uint32_t runWidth = std::min(width, tileX * dirtyTileSize) - left;
+
+			size_t match = rectangles.size();
+			for (size_t i : open) {
+				if (rectangles[i].offset.x == left && rectangles[i].extent.width == runWidth) {
+					match = i;
+					break;
+				}
+			}
+
+			if (match < rectangles.size()) {
+				rectangles[match].extent.height += bottom - top;
+			}
+			else {
+				rectangles.push_back(vk::Rect2D(vk::Offset2D(left, top), vk::Extent2D(runWidth, bottom - top)));
+			}
+			stillOpen.push_back(match);
+		}
+
+		open.swap(stillOpen);
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include "../../config.h"
+#include "../../linear_algebros.h"
+
+namespace raster {
+
+	/**
+		Width and height of a dirty tile (in pixels)
+	*/
+	const int dirtyTileSize = 32;
+
+	/**
+		Records which tiles of a framebuffer have been drawn to, so that
+		only the parts of a frame which changed need to be uploaded.
+	*/
+	class DirtyTiles {
+
+	public:
+
+		//one flag per tile, bytes rather than bits so tiles can be marked independently
+		std::vector<unsigned char> dirty;
+		int width{ 0 }, height{ 0 };
+		int tileCountX{ 0 }, tileCountY{ 0 };
+
+		/**
+			Size the tiles for a framebuffer and mark every one of them clean.
+
+			\param width the width of the framebuffer
+			\param height the height of the framebuffer
+		*/
+		void resize(int width, int height);
+
+		/**
+			Mark every tile overlapping a rectangle.
+
+			\param x1 the rectangle's left edge (inclusive)
+			\param y1 the rectangle's top edge (inclusive)
+			\param x2 the rectangle's right edge (inclusive)
+			\param y2 the rectangle's bottom edge (inclusive)
+		*/
+		void mark(int x1, int y1, int x2, int y2);
+
+		/**
+			Mark every tile a projected polygon could touch.
+
+			\param polygon the polygon, in screen coordinates
+		*/
+		void mark(const edgeTable& polygon);
+
+		/**
+			Mark every tile.
+		*/
+		void mark_all();
+
+		/**
+			Mark every tile which is marked in another set of the same size.
+
+			\param other the tiles to add
+		*/
+		void merge(const DirtyTiles& other);
+
+		/**
+			Mark every tile clean.
+		*/
+		void clear();
+
+		/**
+			\returns whether no tile is marked
+		*/
+		bool empty() const;
+
+		/**
+			\returns whether every tile is marked
+		*/
+		bool full() const;
+
+		/**
+			Cover the marked tiles with as few rectangles as is easy to find:
+			runs of tiles along each row, stacked where consecutive rows match.
+
+			\param rectangles set to the rectangles, in pixels and clamped to the framebuffer
+		*/
+		void regions(std::vector<vk::Rect2D>& rectangles) const;
+	};
+}
@@ -0,0 +1,110 @@
+#include "hi_z.h"
+
+void raster::HiZ::clear(int width, int height) {
+
+	this->width = width;
+	this->height = height;
+	blockCountX = (width + hiZBlockSize - 1) / hiZBlockSize;
+	blockCountY = (height + hiZBlockSize - 1) / hiZBlockSize;
+
+	maxDepth.assign(blockCountX * blockCountY, 1.0f);
+}
+
+void raster::HiZ::update(const float* depth, int x1, int y1, int x2, int y2) {
+
+	x1 = std::max(0, x1);
+	y1 = std::max(0, y1);
+	x2 = std::min(width - 1, x2);
+	y2 = std::min(height - 1, y2);
+
+	if (x1 > x2 || y1 > y2) {
+		return;
+	}
+
+	for (int blockY = y1 / hiZBlockSize; blockY <= y2 / hiZBlockSize; ++blockY) {
+		for (int blockX = x1 / hiZBlockSize; blockX <= x2 / hiZBlockSize; ++blockX) {
+
+			int left = blockX * hiZBlockSize;
+			int top = blockY * hiZBlockSize;
+			int right = std::min(width, left + hiZBlockSize);
+			int bottom = std::min(height, top + hiZBlockSize);
+
+			float farthest = 0.0f;
+
+			if (right - left == hiZBlockSize) {
+				//a full block row is exactly one register
+				__m256 rowMax = _mm256_loadu_ps(depth + width * top + left);
+				for (int y = top + 1; y < bottom; ++y) {
+					rowMax = _mm256_max_ps(rowMax, _mm256_loadu_ps(depth + width * y + left));
+				}
+				__m128 halves = _mm_max_ps(_mm256_castps256_ps128(rowMax), _mm256_extractf128_ps(rowMax, 1));
+				halves = _mm_max_ps(halves, _mm_movehl_ps(halves, halves));
+				halves = _mm_max_ss(halves, _mm_shuffle_ps(halves, halves, 1));
+				farthest = _mm_cvtss_f32(halves);
+			}
+			else {
+				farthest = depth[width * top + left];
+				for (int y = top; y < bottom; ++y) {
+					for (int x = left; x < right; ++x) {
+						farthest = std::max(farthest, depth[width * y + x]);
+					}
+				}
+			}
+
+			maxDepth[blockCountX * blockY + blockX] = farthest;
+		}
+	}
+}
+
+void raster::HiZ::update(const float* depth, edgeTable& polygon) {
+
+	int x_min = width, y_min = height, x_max = -1, y_max = -1;
+
+	for (int i = 0; i < polygon.vertexCount; ++i) {
+		x_min = std::min(x_min, (int)polygon.vertices[i].data[0]);
+		x_max = std::max(x_max, (int)polygon.vertices[i].data[0]);
+		y_min = std::min(y_min, (int)polygon.vertices[i].data[1]);
+		y_max = std::max(y_max, (int)polygon.vertices[i].data[1]);
+	}
+
+	update(depth, x_min, y_min, x_max, y_max);
+}
+
+bool raster::HiZ::occluded(float nearestDepth, int x1, int y1, int x2, int y2) {
+
+	x1 = std::max(0, x1);
+	y1 = std::max(0, y1);
+	x2 = std::min(width - 1, x2);
+	y2 = std::min(height - 1, y2);
+
+	//nothing to compare against
+	if (maxDepth.empty() || x1 > x2 || y1 > y2) {
+		return false;
+	}
+
+	for (int blockY = y1 / hiZBlockSize; blockY <= y2 / hiZBlockSize; ++blockY) {
+		for (int blockX = x1 / hiZBlockSize; blockX <= x2 / hiZBlockSize; ++blockX) {
+			if (nearestDepth < maxDepth[blockCountX * blockY + blockX]) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool raster::HiZ::occluded(edgeTable& polygon) {
+
+	int x_min = width, y_min = height, x_max = -1, y_max = -1;
+	float nearestDepth = 1.0f;
+
+	for (int i = 0; i < polygon.vertexCount; ++i) {
+		x_min = std::min(x_min, (int)polygon.vertices[i].data[0]);
+		x_max = std::max(x_max, (int)polygon.vertices[i].data[0]);
+		y_min = std::min(y_min, (int)polygon.vertices[i].data[1]);
+		y_max = std::max(y_max, (int)polygon.vertices[i].data[1]);
+		nearestDepth = std::min(nearestDepth, polygon.payloads[i].data[5]);
+	}
+
+	return occluded(nearestDepth, x_min, y_min, x_max, y_max);
+}
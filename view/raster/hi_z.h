@@ -0,0 +1,73 @@
+#pragma once
+#include "../../config.h"
+#include "../../linear_algebros.h"
+
+namespace raster {
+
+	/**
+		Width and height of a coarse depth block (in pixels)
+	*/
+	const int hiZBlockSize = 8;
+
+	/**
+		A coarse copy of a depth buffer, holding the farthest depth in
+		each 8x8 block of pixels. A polygon which is behind the farthest
+		depth of every block it could touch can't pass a single depth
+		test, so it can be thrown away before it's clipped or rasterized.
+	*/
+	class HiZ {
+
+	public:
+
+		std::vector<float> maxDepth;
+		int width{ 0 }, height{ 0 };
+		int blockCountX{ 0 }, blockCountY{ 0 };
+
+		/**
+			Size the blocks for a framebuffer and reset them to the far plane.
+
+			\param width the width of the framebuffer
+			\param height the height of the framebuffer
+		*/
+		void clear(int width, int height);
+
+		/**
+			Recompute every block overlapping a rectangle of the depth buffer.
+
+			\param depth the full resolution depth buffer
+			\param x1 the rectangle's left edge (inclusive)
+			\param y1 the rectangle's top edge (inclusive)
+			\param x2 the rectangle's right edge (inclusive)
+			\param y2 the rectangle's bottom edge (inclusive)
+		*/
+		void update(const float* depth, int x1, int y1, int x2, int y2);
+
+		/**
+			Recompute every block a projected polygon could have touched.
+
+			\param depth the full resolution depth buffer
+			\param polygon the polygon, in screen coordinates
+		*/
+		void update(const float* depth, edgeTable& polygon);
+
+		/**
+			Conservatively test a rectangle of fragments against the blocks.
+
+			\param nearestDepth the smallest depth any of the fragments can have
+			\param x1 the rectangle's left edge (inclusive)
+			\param y1 the rectangle's top edge (inclusive)
+			\param x2 the rectangle's right edge (inclusive)
+			\param y2 the rectangle's bottom edge (inclusive)
+			\returns whether every fragment is sure to fail the depth test
+		*/
+		bool occluded(float nearestDepth, int x1, int y1, int x2, int y2);
+
+		/**
+			Conservatively test a projected polygon against the blocks.
+
+			\param polygon the polygon, in screen coordinates with depth in payload lane 5
+			\returns whether every fragment is sure to fail the depth test
+		*/
+		bool occluded(edgeTable& polygon);
+	};
+}
@@ -0,0 +1,85 @@
+#include "tile_bins.h"
+#include "../graphics_library.h"
+
+void raster::TileBins::add_polygon(edgeTable& polygon, texture* tex, bool halfSpace, bool perspective, int width, int height) {
+
+	binnedPolygon binned;
+	binned.firstCorner = static_cast<int>(corners.size());
+	binned.cornerCount = polygon.vertexCount;
+	binned.tex = tex;
+	binned.halfSpace = halfSpace;
+	binned.perspective = perspective;
+	binned.x_min = width;
+	binned.x_max = 0;
+	binned.y_min = height;
+	binned.y_max = 0;
+	binned.nearestDepth = 1.0f;
+
+	for (int i = 0; i < polygon.vertexCount; ++i) {
+
+		vertex corner;
+		corner.x = snap_to_subpixel(polygon.vertices[i].data[0]);
+		corner.y = snap_to_subpixel(polygon.vertices[i].data[1]);
+		if (perspective) {
+			corner.attributes = linalgMakePerspectivePayload(polygon.payloads[i], polygon.vertices[i].data[3]);
+		}
+		else {
+			corner.attributes = polygon.payloads[i];
+		}
+		corners.push_back(corner);
+
+		int x = subpixel_to_pixel(corner.x);
+		int y = subpixel_to_pixel(corner.y);
+		binned.x_min = std::min(binned.x_min, std::max(0, x));
+		binned.x_max = std::max(binned.x_max, std::min(width - 1, x));
+		binned.y_min = std::min(binned.y_min, std::max(0, y));
+		binned.y_max = std::max(binned.y_max, std::min(height - 1, y));
+		binned.nearestDepth = std::min(binned.nearestDepth, polygon.payloads[i].data[5]);
+	}
+
+	if (binned.y_min > binned.y_max || binned.x_min > binned.x_max) {
+		corners.resize(binned.firstCorner);
+		return;
+	}
+
+	if (tex) {
+		binned.dPdy = attribute_gradient_y(corners.data() + binned.firstCorner, binned.cornerCount);
+	}
+
+	//the half-space rasterizer doesn't need scanline tables
+	binned.firstRow = rowCount;
+	if (!halfSpace) {
+		rowCount += binned.y_max - binned.y_min + 1;
+	}
+
+	polygons.push_back(binned);
+}
+
+void raster::TileBins::bin_polygons(int width, int height) {
+
+	tileCountX = (width + tileSize - 1) / tileSize;
+	tileCountY = (height + tileSize - 1) / tileSize;
+	tiles.resize(tileCountX * tileCountY);
+
+	for (std::vector<int>& tile : tiles) {
+		tile.clear();
+	}
+
+	for (int i = 0; i < static_cast<int>(polygons.size()); ++i) {
+
+		binnedPolygon& polygon = polygons[i];
+
+		for (int y = polygon.y_min / tileSize; y <= polygon.y_max / tileSize; ++y) {
+			for (int x = polygon.x_min / tileSize; x <= polygon.x_max / tileSize; ++x) {
+				tiles[tileCountX * y + x].push_back(i);
+			}
+		}
+	}
+}
+
+void raster::TileBins::clear() {
+
+	polygons.clear();
+	corners.clear();
+	rowCount = 0;
+}
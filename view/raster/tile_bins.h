@@ -0,0 +1,78 @@
+#pragma once
+#include "../../config.h"
+#include "../vkImage/image.h"
+#include "../../linear_algebros.h"
+
+namespace raster {
+
+	/**
+		Width and height of a screen tile (in pixels)
+	*/
+	const int tileSize = 64;
+
+	/**
+		A polygon waiting to be rasterized, its corners and scanline
+		tables live in the TileBins which own it.
+	*/
+	struct binnedPolygon {
+		int firstCorner, cornerCount;
+		int x_min, x_max, y_min, y_max;
+		int firstRow;
+		//null for color blended polygons
+		texture* tex;
+		//rasterize with edge functions instead of scanline tables
+		bool halfSpace;
+		//corner attributes are divided by w, with 1/w in lane 7
+		bool perspective;
+		//smallest depth of any corner, for occlusion tests
+		float nearestDepth;
+		//the attributes' rate of change per row, for choosing mip levels
+		payload dPdy;
+	};
+
+	/**
+		Sorts projected polygons into screen tiles, so that each tile
+		can be rasterized independently of the others.
+	*/
+	class TileBins {
+
+	public:
+
+		std::vector<binnedPolygon> polygons;
+		//snapped to 28.4 fixed point
+		std::vector<vertex> corners;
+
+		//scanline tables, each polygon owns rows [firstRow, firstRow + y_max - y_min]
+		std::vector<vertex> rowStart, rowEnd;
+		int rowCount{ 0 };
+
+		//polygon indices touching each tile, in submission order
+		std::vector<std::vector<int>> tiles;
+		int tileCountX{ 0 }, tileCountY{ 0 };
+
+		/**
+			Store a projected polygon for later.
+
+			\param polygon the polygon, in screen coordinates
+			\param tex the texture to sample, or null to blend vertex colors
+			\param halfSpace whether to use the half-space rasterizer
+			\param perspective whether to prepare the attributes for perspective correction
+			\param width the width of the framebuffer
+			\param height the height of the framebuffer
+		*/
+		void add_polygon(edgeTable& polygon, texture* tex, bool halfSpace, bool perspective, int width, int height);
+
+		/**
+			Sort every stored polygon into the tiles its bounding box touches.
+
+			\param width the width of the framebuffer
+			\param height the height of the framebuffer
+		*/
+		void bin_polygons(int width, int height);
+
+		/**
+			Forget all stored polygons, keeping the allocations around.
+		*/
+		void clear();
+	};
+}
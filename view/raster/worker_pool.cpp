@@ -0,0 +1,104 @@
+#include "worker_pool.h"
+
+raster::WorkerPool::WorkerPool(int threadCount) {
+
+	if (threadCount <= 0) {
+		threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+	}
+
+	for (int i = 0; i < threadCount - 1; ++i) {
+		workers.push_back(std::thread(&WorkerPool::work, this));
+	}
+}
+
+raster::WorkerPool::~WorkerPool() {
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		running = false;
+	}
+	wake.notify_all();
+
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+int raster::WorkerPool::get_thread_count() {
+	return static_cast<int>(workers.size()) + 1;
+}
+
+void raster::WorkerPool::run(int jobCount, const std::function<void(int)>& job) {
+
+	if (jobCount <= 0) {
+		return;
+	}
+
+	if (workers.empty() || jobCount == 1) {
+		for (int i = 0; i < jobCount; ++i) {
+			job(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		this->job = &job;
+		this->jobCount = jobCount;
+		nextJob = 0;
+		finishedJobs = 0;
+		generation += 1;
+	}
+	wake.notify_all();
+
+	drain(&job, jobCount);
+
+	//wait for the stragglers, then make sure nobody still holds the job
+	std::unique_lock<std::mutex> guard(lock);
+	done.wait(guard, [this]() { return finishedJobs == this->jobCount && busyWorkers == 0; });
+	this->job = nullptr;
+}
+
+void raster::WorkerPool::drain(const std::function<void(int)>* job, int jobCount) {
+
+	int i;
+	while ((i = nextJob.fetch_add(1)) < jobCount) {
+		(*job)(i);
+		finishedJobs.fetch_add(1);
+	}
+}
+
+void raster::WorkerPool::work() {
+
+	int seenGeneration = 0;
+	const std::function<void(int)>* currentJob;
+	int currentJobCount;
+
+	while (true) {
+
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [this, seenGeneration]() { return !running || generation != seenGeneration; });
+			if (!running) {
+				return;
+			}
+			seenGeneration = generation;
+
+			//woke up too late, the batch has already been finished
+			if (job == nullptr) {
+				continue;
+			}
+			currentJob = job;
+			currentJobCount = jobCount;
+			busyWorkers += 1;
+		}
+
+		drain(currentJob, currentJobCount);
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			busyWorkers -= 1;
+		}
+		done.notify_all();
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "../../config.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+namespace raster {
+
+	/**
+		A fixed set of worker threads which cooperatively chew through
+		numbered jobs. The calling thread joins in as well, so a pool
+		with no workers simply runs everything inline.
+	*/
+	class WorkerPool {
+
+	public:
+
+		/**
+			\param threadCount total number of threads to work with (including
+				the calling thread), 0 picks one per hardware thread
+		*/
+		WorkerPool(int threadCount = 0);
+
+		~WorkerPool();
+
+		/**
+			Run job(0) ... job(jobCount - 1) across the pool, returning once
+			every job has finished. Jobs are picked up in increasing order but
+			may finish in any order, so they must not touch shared data.
+
+			\param jobCount the number of jobs
+			\param job the work to do for each job index
+		*/
+		void run(int jobCount, const std::function<void(int)>& job);
+
+		/**
+			\returns the number of threads (including the caller) doing work
+		*/
+		int get_thread_count();
+
+	private:
+
+		std::vector<std::thread> workers;
+		std::mutex lock;
+		std::condition_variable wake, done;
+
+		const std::function<void(int)>* job{ nullptr };
+		int jobCount{ 0 };
+		std::atomic<int> nextJob{ 0 };
+		std::atomic<int> finishedJobs{ 0 };
+		int generation{ 0 };
+		int busyWorkers{ 0 };
+		bool running{ true };
+
+		void work();
+
+		void drain(const std::function<void(int)>* job, int jobCount);
+	};
+}
@@ -0,0 +1,55 @@
+#include "render_target.h"
+
+renderTarget::MemoryTarget::MemoryTarget(vk::Format format, FrameSink sink) {
+
+	this->format = format;
+	this->sink = sink;
+}
+
+vk::Format renderTarget::MemoryTarget::get_format() {
+	return format;
+}
+
+void renderTarget::MemoryTarget::present(const unsigned char* colorBufferData, int width, int height) {
+
+	lastFrame = colorBufferData;
+	frameCount += 1;
+
+	if (sink) {
+		sink(colorBufferData, width, height);
+	}
+}
+
+void renderTarget::MemoryTarget::present_regions(const unsigned char* colorBufferData, int width, int height,
+	const std::vector<vk::Rect2D>& regions) {
+
+	kept.resize(4 * (size_t)width * height);
+	uploadedPixels = 0;
+
+	for (const vk::Rect2D& region : regions) {
+		for (uint32_t y = region.offset.y; y < region.offset.y + region.extent.height; ++y) {
+			size_t offset = 4 * ((size_t)width * y + region.offset.x);
+			memcpy(kept.data() + offset, colorBufferData + offset, 4 * region.extent.width);
+		}
+		uploadedPixels += region.extent.width * region.extent.height;
+	}
+
+	lastFrame = kept.data();
+	frameCount += 1;
+
+	if (sink) {
+		sink(lastFrame, width, height);
+	}
+}
+
+const unsigned char* renderTarget::MemoryTarget::get_last_frame() {
+	return lastFrame;
+}
+
+int renderTarget::MemoryTarget::get_frame_count() {
+	return frameCount;
+}
+
+int renderTarget::MemoryTarget::get_uploaded_pixel_count() {
+	return uploadedPixels;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "../../config.h"
+#include <functional>
+
+namespace renderTarget {
+
+	/**
+		Receives finished frames from the engine.
+
+		The vulkan swapchain is the engine's default destination, an engine
+		constructed with a RenderTarget instead skips all vulkan setup and
+		hands each finished color buffer to the target.
+	*/
+	class RenderTarget {
+
+	public:
+
+		virtual ~RenderTarget() = default;
+
+		/**
+			\returns the pixel format the target expects the color buffer in
+		*/
+		virtual vk::Format get_format() = 0;
+
+		/**
+			Receive a finished frame.
+
+			\param colorBufferData the frame's pixels, 4 bytes per pixel, tightly packed
+			\param width the width of the frame (in pixels)
+			\param height the height of the frame (in pixels)
+		*/
+		virtual void present(const unsigned char* colorBufferData, int width, int height) = 0;
+
+		/**
+			Receive a finished frame of which only some regions changed since
+			the last one, while the engine tracks dirty tiles. Targets which
+			don't keep their own copy of the frame just take all of it.
+
+			\param colorBufferData the frame's pixels, 4 bytes per pixel, tightly packed
+			\param width the width of the frame (in pixels)
+			\param height the height of the frame (in pixels)
+			\param regions the rectangles which changed, the first frame after
+				tracking starts covers the whole frame
+		*/
+		virtual void present_regions(const unsigned char* colorBufferData, int width, int height,
+			const std::vector<vk::Rect2D>& regions) {
+			present(colorBufferData, width, height);
+		}
+	};
+
+	/**
+		Function which consumes a finished frame, eg. writes it to disk.
+	*/
+	typedef std::function<void(const unsigned char*, int, int)> FrameSink;
+
+	/**
+		Pure memory render target. Frames stay in the engine's color buffer,
+		the target just remembers the most recent one and forwards it to
+		an (optional) sink.
+	*/
+	class MemoryTarget : public RenderTarget {
+
+	public:
+
+		/**
+			\param format the pixel format to request from the engine
+			\param sink called with every finished frame, can be empty
+		*/
+		MemoryTarget(vk::Format format = vk::Format::eR8G8B8A8Unorm, FrameSink sink = nullptr);
+
+		vk::Format get_format() override;
+
+		void present(const unsigned char* colorBufferData, int width, int height) override;
+
+		/**
+			Copy the changed regions into a frame the target keeps, the way
+			a swapchain image holds on to what was uploaded before.
+		*/
+		void present_regions(const unsigned char* colorBufferData, int width, int height,
+			const std::vector<vk::Rect2D>& regions) override;
+
+		/**
+			\returns the most recent frame, only valid until the engine
+			draws over that buffer again (or, with regions presented, until
+			the next frame is)
+		*/
+		const unsigned char* get_last_frame();
+
+		/**
+			\returns the number of frames presented so far
+		*/
+		int get_frame_count();
+
+		/**
+			\returns the number of pixels copied by the last present_regions
+		*/
+		int get_uploaded_pixel_count();
+
+	private:
+
+		vk::Format format;
+		FrameSink sink;
+		const unsigned char* lastFrame = nullptr;
+		int frameCount = 0;
+		//the target's own copy of the frame, for regions to be copied into
+		std::vector<unsigned char> kept;
+		int uploadedPixels = 0;
+	};
+}
@@ -1,19 +1,50 @@
-#pragma once
-#include "../../config.h"
-
-typedef struct {
-	float* r;
-	float* g;
-	float* b;
-	int width, height;
-} texture;
-
-namespace vkImage {
-
-	/**
-		Create a view of a vulkan image.
-	*/
-	vk::ImageView make_image_view(
-		vk::Device logicalDevice, vk::Image image, vk::Format format,
-		vk::ImageAspectFlags aspect);
+#pragma once
+#include "../../config.h"
+
+typedef struct texture {
+	//planar layout, one float per channel per texel (null when packed)
+	float* r;
+	float* g;
+	float* b;
+	//packed layout, RGBA8 texels in 4x4 tiles of one cache line each (null when planar)
+	uint32_t* texels;
+	int tilesPerRow;
+	int width, height;
+	//mip chain, levels[0] is the full size image (sharing r, g and b above)
+	//and every level after it is half the size of the one before
+	struct texture* levels;
+	int levelCount;
+} texture;
+
+/**
+	How a texture's texels are laid out in memory
+*/
+enum class textureLayout {
+	//separate float planes for r, g and b, 12 bytes per texel
+	planar,
+	//RGBA8 texels stored in 4x4 tiles, 4 bytes per texel, so a bilinear
+	//footprint usually lies in a single cache line
+	packedTiled
+};
+
+/**
+	How textures are filtered between mip levels
+*/
+enum class textureFilter {
+	//bilinear from the full size image only
+	bilinear,
+	//bilinear from the level closest to the span's footprint
+	nearestMip,
+	//bilinear from the two closest levels, blended
+	trilinear
+};
+
+namespace vkImage {
+
+	/**
+		Create a view of a vulkan image.
+	*/
+	vk::ImageView make_image_view(
+		vk::Device logicalDevice, vk::Image image, vk::Format format,
+		vk::ImageAspectFlags aspect);
 }
\ No newline at end of file
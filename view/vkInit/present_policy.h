@@ -0,0 +1,13 @@
+#pragma once
+
+/**
+	How finished frames are presented, trading latency against throughput
+*/
+enum class presentPolicy {
+	//immediate (or mailbox) with as few images as possible, may tear
+	lowestLatency,
+	//mailbox (or immediate) with spare images, never waits on the display
+	maxThroughput,
+	//fifo, one frame per vertical blank
+	pacedVsync
+};
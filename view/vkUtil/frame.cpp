@@ -1,96 +1,206 @@
-#include "frame.h"
-#include "memory.h"
-
-void vkUtil::SwapChainFrame::setup() {
-
-	colorBufferData.reserve(4 * width * height);
-
-	for (int i = 0; i < width * height; ++i) {
-		colorBufferData.push_back(0xff);
-		colorBufferData.push_back(0x00);
-		colorBufferData.push_back(0x00);
-		colorBufferData.push_back(0x00);
-	}
-
-	BufferInputChunk input;
-	input.logicalDevice = logicalDevice;
-	input.physicalDevice = physicalDevice;
-	input.memoryProperties = vk::MemoryPropertyFlagBits::eHostCoherent | vk::MemoryPropertyFlagBits::eHostVisible;
-	input.usage = vk::BufferUsageFlagBits::eTransferSrc;
-	input.size = width * height * 4;
-
-	stagingBuffer = vkUtil::createBuffer(input);
-
-	writeLocation = logicalDevice.mapMemory(stagingBuffer.bufferMemory, 0, input.size);
-
-	colorBufferAccess.aspectMask = vk::ImageAspectFlagBits::eColor;
-	colorBufferAccess.baseMipLevel = 0;
-	colorBufferAccess.levelCount = 1;
-	colorBufferAccess.baseArrayLayer = 0;
-	colorBufferAccess.layerCount = 1;
-
-	barrier.oldLayout = vk::ImageLayout::eUndefined;
-	barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
-	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.image = image;
-	barrier.subresourceRange = colorBufferAccess;
-	barrier.srcAccessMask = vk::AccessFlagBits::eNoneKHR;
-	barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
-
-	copy.bufferOffset = 0;
-	copy.bufferRowLength = 0;
-	copy.bufferImageHeight = 0;
-
-	copyAccess.aspectMask = vk::ImageAspectFlagBits::eColor;
-	copyAccess.mipLevel = 0;
-	copyAccess.baseArrayLayer = 0;
-	copyAccess.layerCount = 1;
-	copy.imageSubresource = copyAccess;
-
-	copy.imageOffset = vk::Offset3D(0, 0, 0);
-	copy.imageExtent = vk::Extent3D(width,height,1);
-
-	barrier2.oldLayout = vk::ImageLayout::eTransferDstOptimal;
-	barrier2.newLayout = vk::ImageLayout::ePresentSrcKHR;
-	barrier2.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier2.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier2.image = image;
-	barrier2.subresourceRange = colorBufferAccess;
-	barrier2.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
-	barrier2.dstAccessMask = vk::AccessFlagBits::eNoneKHR;
-
-}
-
-void vkUtil::SwapChainFrame::flush() {
-
-	memcpy(writeLocation, colorBufferData.data(), width * height * 4);
-
-	commandBuffer.pipelineBarrier(
-		vk::PipelineStageFlagBits::eTopOfPipe, 
-		vk::PipelineStageFlagBits::eTransfer, 
-		vk::DependencyFlags(), nullptr, nullptr, barrier);
-
-	commandBuffer.copyBufferToImage(
-		stagingBuffer.buffer, image, vk::ImageLayout::eTransferDstOptimal, copy
-	);
-
-	commandBuffer.pipelineBarrier(
-		vk::PipelineStageFlagBits::eTransfer,
-		vk::PipelineStageFlagBits::eBottomOfPipe,
-		vk::DependencyFlags(), nullptr, nullptr, barrier2);
-
-}
-
-void vkUtil::SwapChainFrame::destroy() {
-
-	logicalDevice.unmapMemory(stagingBuffer.bufferMemory);
-	logicalDevice.freeMemory(stagingBuffer.bufferMemory);
-	logicalDevice.destroyBuffer(stagingBuffer.buffer);
-
-	logicalDevice.destroyImageView(imageView);
-	logicalDevice.destroyFence(inFlight);
-	logicalDevice.destroySemaphore(imageAvailable);
-	logicalDevice.destroySemaphore(renderFinished);
-
+#include "frame.h"
+#include "memory.h"
+#include "../../control/profiler.h"
+#include <new>
+
+namespace {
+
+	//the same alignment vulkan guarantees for mapped memory (minMemoryMapAlignment)
+	const std::align_val_t colorBufferAlignment{ 64 };
+
+	//pixels start out red, as they always have
+	void fill_color_buffer(unsigned char* colorBufferData, int pixelCount) {
+
+		uint32_t* pixels = reinterpret_cast<uint32_t*>(colorBufferData);
+		std::fill(pixels, pixels + pixelCount, 0x000000ffu);
+	}
+}
+
+void vkUtil::SwapChainFrame::setup_color_buffer() {
+
+	colorBufferData = static_cast<unsigned char*>(operator new(4 * width * height, colorBufferAlignment));
+	fill_color_buffer(colorBufferData, width * height);
+}
+
+void vkUtil::SwapChainFrame::free_color_buffer() {
+
+	operator delete(colorBufferData, colorBufferAlignment);
+	colorBufferData = nullptr;
+}
+
+void vkUtil::SwapChainFrame::setup_depth_buffer() {
+
+	depthBufferData.assign(width * height, 1.0f);
+}
+
+void vkUtil::SwapChainFrame::setup() {
+
+	setup_depth_buffer();
+	setup_staging_buffer();
+	fill_color_buffer(colorBufferData, width * height);
+
+	colorBufferAccess.aspectMask = vk::ImageAspectFlagBits::eColor;
+	colorBufferAccess.baseMipLevel = 0;
+	colorBufferAccess.levelCount = 1;
+	colorBufferAccess.baseArrayLayer = 0;
+	colorBufferAccess.layerCount = 1;
+
+	barrier.oldLayout = vk::ImageLayout::eUndefined;
+	barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = image;
+	barrier.subresourceRange = colorBufferAccess;
+	barrier.srcAccessMask = vk::AccessFlagBits::eNoneKHR;
+	barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+
+	copy.bufferOffset = 0;
+	copy.bufferRowLength = 0;
+	copy.bufferImageHeight = 0;
+
+	copyAccess.aspectMask = vk::ImageAspectFlagBits::eColor;
+	copyAccess.mipLevel = 0;
+	copyAccess.baseArrayLayer = 0;
+	copyAccess.layerCount = 1;
+	copy.imageSubresource = copyAccess;
+
+	copy.imageOffset = vk::Offset3D(0, 0, 0);
+	copy.imageExtent = vk::Extent3D(width,height,1);
+
+	barrier2.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+	barrier2.newLayout = vk::ImageLayout::ePresentSrcKHR;
+	barrier2.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier2.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier2.image = image;
+	barrier2.subresourceRange = colorBufferAccess;
+	barrier2.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+	barrier2.dstAccessMask = vk::AccessFlagBits::eNoneKHR;
+
+}
+
+void vkUtil::SwapChainFrame::setup_staging_buffer() {
+
+	BufferInputChunk input;
+	input.logicalDevice = logicalDevice;
+	input.physicalDevice = physicalDevice;
+	input.memoryProperties = vk::MemoryPropertyFlagBits::eHostCoherent | vk::MemoryPropertyFlagBits::eHostVisible;
+	//frames catch up by copying out of each other's staging memory, and reads from
+	//uncached memory (usually write combined) are slow
+	input.preferredProperties = vk::MemoryPropertyFlagBits::eHostCached;
+	input.usage = vk::BufferUsageFlagBits::eTransferSrc;
+	input.size = width * height * 4;
+
+	stagingBuffer = vkUtil::createBuffer(input);
+	stagingCapacity = input.size;
+
+	//mapped for the frame's whole life and drawn into directly
+	colorBufferData = static_cast<unsigned char*>(logicalDevice.mapMemory(stagingBuffer.bufferMemory, 0, input.size));
+}
+
+void vkUtil::SwapChainFrame::destroy_staging_buffer() {
+
+	logicalDevice.unmapMemory(stagingBuffer.bufferMemory);
+	colorBufferData = nullptr;
+	logicalDevice.freeMemory(stagingBuffer.bufferMemory);
+	logicalDevice.destroyBuffer(stagingBuffer.buffer);
+	stagingCapacity = 0;
+}
+
+void vkUtil::SwapChainFrame::resize(int width, int height) {
+
+	this->width = width;
+	this->height = height;
+
+	//keeps its capacity when shrinking
+	setup_depth_buffer();
+
+	if (4 * (vk::DeviceSize)width * height > stagingCapacity) {
+		destroy_staging_buffer();
+		setup_staging_buffer();
+	}
+
+	copy.imageExtent = vk::Extent3D(width, height, 1);
+}
+
+void vkUtil::SwapChainFrame::flush(vk::Image destination) {
+
+	PROFILE_SCOPE(flush);
+
+	barrier.image = destination;
+	barrier2.image = destination;
+
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTopOfPipe, 
+		vk::PipelineStageFlagBits::eTransfer, 
+		vk::DependencyFlags(), nullptr, nullptr, barrier);
+
+	commandBuffer.copyBufferToImage(
+		stagingBuffer.buffer, destination, vk::ImageLayout::eTransferDstOptimal, copy
+	);
+
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTransfer,
+		vk::PipelineStageFlagBits::eBottomOfPipe,
+		vk::DependencyFlags(), nullptr, nullptr, barrier2);
+
+}
+
+void vkUtil::SwapChainFrame::flush(vk::Image destination, const std::vector<vk::Rect2D>& regions) {
+
+	if (regions.empty()) {
+		return;
+	}
+
+	PROFILE_SCOPE(flush);
+	regionCopies.clear();
+	for (const vk::Rect2D& region : regions) {
+		vk::BufferImageCopy regionCopy = copy;
+		regionCopy.bufferOffset = 4 * (width * region.offset.y + region.offset.x);
+		regionCopy.bufferRowLength = width;
+		regionCopy.bufferImageHeight = height;
+		regionCopy.imageOffset = vk::Offset3D(region.offset.x, region.offset.y, 0);
+		regionCopy.imageExtent = vk::Extent3D(region.extent.width, region.extent.height, 1);
+		regionCopies.push_back(regionCopy);
+	}
+
+	//coming from the present layout rather than undefined, so what isn't copied over survives
+	vk::ImageMemoryBarrier preserve = barrier;
+	preserve.oldLayout = vk::ImageLayout::ePresentSrcKHR;
+	preserve.image = destination;
+	barrier2.image = destination;
+
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTopOfPipe,
+		vk::PipelineStageFlagBits::eTransfer,
+		vk::DependencyFlags(), nullptr, nullptr, preserve);
+
+	commandBuffer.copyBufferToImage(
+		stagingBuffer.buffer, destination, vk::ImageLayout::eTransferDstOptimal, regionCopies
+	);
+
+	commandBuffer.pipelineBarrier(
+		vk::PipelineStageFlagBits::eTransfer,
+		vk::PipelineStageFlagBits::eBottomOfPipe,
+		vk::DependencyFlags(), nullptr, nullptr, barrier2);
+}
+
+void vkUtil::SwapChainFrame::copy_regions(const SwapChainFrame& source, const std::vector<vk::Rect2D>& regions) {
+
+	for (const vk::Rect2D& region : regions) {
+		for (uint32_t y = region.offset.y; y < region.offset.y + region.extent.height; ++y) {
+			size_t offset = 4 * ((size_t)width * y + region.offset.x);
+			memcpy(colorBufferData + offset, source.colorBufferData + offset, 4 * region.extent.width);
+		}
+	}
+}
+
+void vkUtil::SwapChainFrame::destroy() {
+
+	destroy_staging_buffer();
+
+	logicalDevice.destroyImageView(imageView);
+	logicalDevice.destroyFence(inFlight);
+	logicalDevice.destroySemaphore(imageAvailable);
+	logicalDevice.destroySemaphore(renderFinished);
+
 }
\ No newline at end of file
@@ -1,50 +1,112 @@
-#pragma once
-#include "../../config.h"
-
-namespace vkUtil {
-
-	/**
-		Holds the data structures associated with a "Frame"
-	*/
-	class SwapChainFrame {
-
-	public:
-
-		//For doing work
-		vk::Device logicalDevice;
-		vk::PhysicalDevice physicalDevice;
-
-		//Swapchain-type stuff
-		vk::Image image;
-		vk::ImageView imageView;
-		int width, height;
-
-		vk::CommandBuffer commandBuffer;
-
-		//Sync objects
-		vk::Semaphore imageAvailable, renderFinished;
-		vk::Fence inFlight;
-
-		//Resources
-		std::vector<unsigned char> colorBufferData;
-
-		//Staging Buffer
-		Buffer stagingBuffer;
-		void* writeLocation;
-
-		//Transition Jobs
-		vk::ImageSubresourceRange colorBufferAccess;
-		vk::ImageMemoryBarrier barrier, barrier2;
-
-		//Copy Job
-		vk::BufferImageCopy copy;
-		vk::ImageSubresourceLayers copyAccess;
-
-		void setup();
-
-		void flush();
-
-		void destroy();
-	};
-
+#pragma once
+#include "../../config.h"
+
+namespace vkUtil {
+
+	/**
+		Holds the data structures associated with a "Frame"
+	*/
+	class SwapChainFrame {
+
+	public:
+
+		//For doing work
+		vk::Device logicalDevice;
+		vk::PhysicalDevice physicalDevice;
+
+		//Swapchain-type stuff
+		vk::Image image;
+		vk::ImageView imageView;
+		int width, height;
+
+		vk::CommandBuffer commandBuffer;
+
+		//Sync objects
+		vk::Semaphore imageAvailable, renderFinished;
+		vk::Fence inFlight;
+
+		//Resources, the color buffer is the mapped staging memory itself, so
+		//there's nothing to copy before the transfer. Always 64 byte aligned
+		unsigned char* colorBufferData{ nullptr };
+		//one float per pixel, smaller is closer
+		std::vector<float> depthBufferData;
+
+		//Staging Buffer, which may be bigger than the frame after a resize
+		Buffer stagingBuffer;
+		vk::DeviceSize stagingCapacity{ 0 };
+
+		//Transition Jobs
+		vk::ImageSubresourceRange colorBufferAccess;
+		vk::ImageMemoryBarrier barrier, barrier2;
+
+		//Copy Job
+		vk::BufferImageCopy copy;
+		vk::ImageSubresourceLayers copyAccess;
+		std::vector<vk::BufferImageCopy> regionCopies;
+
+		/**
+			Allocate the cpu side color buffer only, this is all a
+			headless frame needs.
+		*/
+		void setup_color_buffer();
+
+		/**
+			Free a color buffer made by setup_color_buffer.
+		*/
+		void free_color_buffer();
+
+		/**
+			Allocate the cpu side depth buffer, cleared to the far plane.
+		*/
+		void setup_depth_buffer();
+
+		void setup();
+
+		/**
+			Make and map a host visible staging buffer big enough for the frame.
+		*/
+		void setup_staging_buffer();
+
+		/**
+			Unmap and free the staging buffer.
+		*/
+		void destroy_staging_buffer();
+
+		/**
+			Fit the frame to a new size. The staging memory is kept if it's still
+			big enough, and nothing is cleared, the next frame drawn overwrites it.
+
+			\param width the new width, in pixels
+			\param height the new height, in pixels
+		*/
+		void resize(int width, int height);
+
+		/**
+			Record the transfer of this frame's pixels to a swapchain image.
+
+			\param destination the image to copy to, which needn't be the one
+				this frame was made for since images aren't always acquired in order
+		*/
+		void flush(vk::Image destination);
+
+		/**
+			Record the transfer of some of this frame's pixels to a swapchain image
+			which has been presented before, the rest of the image keeps its contents.
+
+			\param destination the image to copy to
+			\param regions the rectangles to copy, in pixels
+		*/
+		void flush(vk::Image destination, const std::vector<vk::Rect2D>& regions);
+
+		/**
+			Bring rectangles of this frame's pixels up to date with another frame.
+
+			\param source a frame of the same size to copy from
+			\param regions the rectangles to copy, in pixels
+		*/
+		void copy_regions(const SwapChainFrame& source, const std::vector<vk::Rect2D>& regions);
+
+		void destroy();
+	};
+
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "frame_queue.h"
+
+void vkUtil::FrameQueue::open(int capacity) {
+
+	std::lock_guard<std::mutex> guard(lock);
+	frames.clear();
+	this->capacity = std::max(1, capacity);
+	busyFrame = -1;
+	closed = false;
+}
+
+void vkUtil::FrameQueue::push(int frame) {
+
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		changed.wait(guard, [this]() { return (int)frames.size() < capacity; });
+		frames.push_back(frame);
+	}
+	changed.notify_all();
+}
+
+bool vkUtil::FrameQueue::pop(int& frame) {
+
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		changed.wait(guard, [this]() { return closed || !frames.empty(); });
+		if (frames.empty()) {
+			return false;
+		}
+		frame = frames.front();
+		frames.pop_front();
+		busyFrame = frame;
+	}
+	//a slot just opened up
+	changed.notify_all();
+	return true;
+}
+
+void vkUtil::FrameQueue::finish(int frame) {
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (busyFrame == frame) {
+			busyFrame = -1;
+		}
+	}
+	changed.notify_all();
+}
+
+void vkUtil::FrameQueue::wait_for(int frame) {
+
+	std::unique_lock<std::mutex> guard(lock);
+	changed.wait(guard, [this, frame]() {
+		return busyFrame != frame && std::find(frames.begin(), frames.end(), frame) == frames.end();
+	});
+}
+
+void vkUtil::FrameQueue::wait_idle() {
+
+	std::unique_lock<std::mutex> guard(lock);
+	changed.wait(guard, [this]() { return busyFrame == -1 && frames.empty(); });
+}
+
+void vkUtil::FrameQueue::close() {
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		closed = true;
+	}
+	changed.notify_all();
+}
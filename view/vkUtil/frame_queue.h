@@ -0,0 +1,74 @@
+#pragma once
+#include "../../config.h"
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace vkUtil {
+
+	/**
+		A bounded queue of finished frames (by index) waiting to be
+		presented, handed from the thread drawing them to the thread
+		presenting them.
+	*/
+	class FrameQueue {
+
+	public:
+
+		/**
+			Empty the queue and open it for frames.
+
+			\param capacity the most frames which may wait at once
+		*/
+		void open(int capacity);
+
+		/**
+			Queue a frame, waiting for room if the queue is full.
+
+			\param frame the frame's index
+		*/
+		void push(int frame);
+
+		/**
+			Take the oldest frame, waiting for one if the queue is empty.
+			The frame counts as busy until it's handed back to finish.
+
+			\param frame set to the frame's index
+			\returns false once the queue has been closed and emptied
+		*/
+		bool pop(int& frame);
+
+		/**
+			Mark a frame taken by pop as dealt with.
+
+			\param frame the frame's index
+		*/
+		void finish(int frame);
+
+		/**
+			Wait until a frame is neither queued nor busy.
+
+			\param frame the frame's index
+		*/
+		void wait_for(int frame);
+
+		/**
+			Wait until every queued frame has been dealt with.
+		*/
+		void wait_idle();
+
+		/**
+			Stop taking frames, pop returns false once the rest are dealt with.
+		*/
+		void close();
+
+	private:
+
+		std::mutex lock;
+		std::condition_variable changed;
+		std::deque<int> frames;
+		int capacity{ 1 };
+		int busyFrame{ -1 };
+		bool closed{ true };
+	};
+}